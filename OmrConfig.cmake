@@ -19,14 +19,27 @@ set(OMR_GC_EXPERIMENTAL_CONTEXT        ON CACHE INTERNAL "")
 set(OMR_GC_EXPERIMENTAL_OBJECT_SCANNER ON CACHE INTERNAL "")
 set(OMR_GC_EXPERIMENTAL_ALLOCATOR      ON CACHE INTERNAL "")
 
-# Disable the scavenger and heap compaction
+# Compressed references are selected by the Splash build option
+
+set(OMR_GC_COMPRESSED_POINTERS ${SPLASH_COMPRESSED_REFS} CACHE INTERNAL "")
+
+# The segregated heap is selected by the Splash build option
+
+set(OMR_GC_SEGREGATED_HEAP ${SPLASH_SEGREGATED_HEAP} CACHE INTERNAL "")
+
+# The scavenger is selected by the Splash build option
+
+set(OMR_GC_MODRON_SCAVENGER ${SPLASH_GENCON} CACHE INTERNAL "")
+
+# Disable heap compaction
 
-set(OMR_GC_MODRON_SCAVENGER  OFF CACHE INTERNAL "")  # SPLASH TODO
 set(OMR_GC_MODRON_COMPACTION OFF CACHE INTERNAL "")  # SPLASH TODO
 
 # Default-on options
 
 set(OMR_GC_THREAD_LOCAL_HEAP ON CACHE INTERNAL "")
+set(OMR_GC_NON_ZERO_TLH ${SPLASH_NON_ZERO_TLH} CACHE INTERNAL "")
+set(OMR_GC_TLH_PREFETCH_FTA ${SPLASH_TLH_PREFETCH} CACHE INTERNAL "")
 set(OMR_NOTIFY_POLICY_CONTROL ON CACHE INTERNAL "")
 set(OMR_THR_CUSTOM_SPIN_OPTIONS ON CACHE INTERNAL "")
 set(OMR_THR_SPIN_CODE_REFACTOR ON CACHE INTERNAL "")
@@ -24,7 +24,15 @@
 
 #include "omrcfg.h"
 #include "ModronAssertions.h"
+#include "objectdescription.h"
 
+#include <Splash/Arrays.hpp>
+
+/*
+ * Splash does not enable OMR_GC_ARRAYLETS. Large arrays are Splash::Spine objects, whose
+ * leaves are ordinary arrays, so the collector scans and moves them like any other object.
+ * This model only describes spines to OMR code built with arraylets enabled.
+ */
 #if defined(OMR_GC_ARRAYLETS)
 
 class MM_GCExtensionsBase;
@@ -46,10 +54,18 @@ public:
 
 	void tearDown(MM_GCExtensionsBase *extensions) {}
 
+	/**
+	 * Returns the arrayoid (the table of leaf references) of a discontiguous array.
+	 * @param arrayPtr Pointer to the indexable object
+	 * @return Pointer to the first leaf slot of a spine, or NULL if the array is contiguous
+	 */
 	MMINLINE fomrobject_t *
 	getArrayoidPointer(omrarrayptr_t arrayPtr)
 	{
-		return (fomrobject_t *) NULL;
+		if (Splash::Kind::SPINE != Splash::kind(arrayPtr)) {
+			return (fomrobject_t *) NULL;
+		}
+		return (fomrobject_t *) arrayPtr->asSpine.begin();
 	}
 
 	MMINLINE void
@@ -66,8 +82,7 @@ public:
 	MMINLINE uintptr_t
 	getSizeInBytesWithHeader(omrarrayptr_t arrayPtr)
 	{
-		Assert_MM_unimplemented();
-		return 0;
+		return Splash::size(arrayPtr);
 	}
 };
 
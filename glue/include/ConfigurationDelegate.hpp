@@ -28,6 +28,9 @@
 #include "EnvironmentBase.hpp"
 #include "GCExtensionsBase.hpp"
 #include "Heap.hpp"
+#if defined(OMR_GC_SEGREGATED_HEAP)
+#include "LanguageSegregatedAllocationCache.hpp"
+#endif /* defined(OMR_GC_SEGREGATED_HEAP) */
 
 class MM_HeapRegionDescriptor;
 
@@ -134,7 +137,14 @@ public:
 #if defined(OMR_GC_SEGREGATED_HEAP)
 	OMR_SizeClasses *getSegregatedSizeClasses(MM_EnvironmentBase *env)
 	{
-		return NULL;
+		OMR_SizeClasses *sizeClasses = MM_LanguageSegregatedAllocationCache::getSizeClasses();
+		uintptr_t regionSize = env->getExtensions()->regionSize;
+
+		for (uintptr_t sizeClass = OMR_SIZECLASSES_MIN_SMALL; sizeClass <= OMR_SIZECLASSES_MAX_SMALL; sizeClass++) {
+			sizeClasses->smallNumCells[sizeClass] = regionSize / sizeClasses->smallCellSizes[sizeClass];
+		}
+
+		return sizeClasses;
 	}
 #endif /* defined(OMR_GC_SEGREGATED_HEAP) */
 
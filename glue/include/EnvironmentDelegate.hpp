@@ -24,8 +24,21 @@
 
 #include "objectdescription.h"
 
+#include <Splash/Arrays.hpp>
+
+#include <string.h>
+
 class MM_EnvironmentBase;
 
+/**
+ * Where a Splash region opened in one TLH.
+ */
+struct GC_RegionMark
+{
+	uint8_t *heapBase; /* the base of the TLH when the region opened */
+	uint8_t *heapAlloc; /* the first byte of the TLH allocated in the region */
+};
+
 /**
  * The GC_Environment class is opaque to OMR and may be used by the client language to
  * maintain language-specific information relating to a OMR VM thread, for example, local
@@ -39,6 +52,39 @@ private:
 protected:
 
 public:
+	/**
+	 * Bytes allocated by this thread at each allocation site since the last GC. Flushed to the
+	 * allocation sites by MM_EnvironmentDelegate::flushNonAllocationCaches().
+	 */
+	uintptr_t siteAllocatedBytes[Splash::SITE_COUNT];
+
+	/**
+	 * Bytes copied by this thread, as a scavenger worker, for each allocation site.
+	 */
+	uintptr_t siteSurvivedBytes[Splash::SITE_COUNT];
+
+	/**
+	 * The number of GCs this thread has been stopped for. Lets debug builds check that no
+	 * collection point passed between allocating an object and initializing it.
+	 */
+	uintptr_t gcCount;
+
+	/**
+	 * The number of Splash regions open on this thread. Only the outermost one is reclaimed.
+	 */
+	uintptr_t regionDepth;
+
+	/**
+	 * Set when an object allocated in the open region may be reachable from outside it: a store
+	 * barrier saw it stored into an object outside the region, or a GC ran while it was open.
+	 */
+	bool regionEscaped;
+
+	/**
+	 * Where the outermost open region started, in the zeroed and non-zeroed TLHs.
+	 */
+	GC_RegionMark regionMark;
+	GC_RegionMark nonZeroRegionMark;
 
 	/* Function members */
 private:
@@ -46,7 +92,16 @@ private:
 protected:
 
 public:
-	GC_Environment() {}
+	GC_Environment()
+	{
+		memset(siteAllocatedBytes, 0, sizeof(siteAllocatedBytes));
+		memset(siteSurvivedBytes, 0, sizeof(siteSurvivedBytes));
+		gcCount = 0;
+		regionDepth = 0;
+		regionEscaped = false;
+		memset(&regionMark, 0, sizeof(regionMark));
+		memset(&nonZeroRegionMark, 0, sizeof(nonZeroRegionMark));
+	}
 };
 
 /***
@@ -145,7 +200,7 @@ public:
 	 * @see GC_Environment
 	 *
 	 */
-	void flushNonAllocationCaches() { }
+	void flushNonAllocationCaches();
 
 	/**
 	 * Set or clear the transient master GC status on this thread. This thread obtains master status
@@ -236,21 +291,22 @@ public:
 	/**
 	 * Disable inline TLH allocates by hiding the real heap allocation address from
 	 * JIT/Interpreter in realHeapAlloc and setting heapALloc == HeapTop so TLH
-	 * looks full.
+	 * looks full. The Splash allocators (see Splash/ThreadLocalHeap.hpp) then take
+	 * the out-of-line path.
 	 *
 	 */
-	void disableInlineTLHAllocate() {}
+	void disableInlineTLHAllocate();
 
 	/**
 	 * Re-enable inline TLH allocate by restoring heapAlloc from realHeapAlloc
 	 */
-	void enableInlineTLHAllocate() {}
+	void enableInlineTLHAllocate();
 
 	/**
 	 * Determine if inline TLH allocate is enabled; its enabled if realheapAlloc is NULL.
 	 * @return TRUE if inline TLH allocates currently enabled for this thread; FALSE otherwise
 	 */
-	bool isInlineTLHAllocateEnabled() { return false; }
+	bool isInlineTLHAllocateEnabled();
 #endif /* OMR_GC_THREAD_LOCAL_HEAP */
 
 	MM_EnvironmentDelegate()
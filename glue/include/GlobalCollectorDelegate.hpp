@@ -97,11 +97,12 @@ public:
 	 * no specific actions are specified for this method.
 	 *
 	 * This is called on the master thread when the marking phase of the collection is complete
-	 * and before the sweeping phase commences.
+	 * and before the sweeping phase commences. Releases the payloads of external arrays that
+	 * were not marked.
 	 *
 	 * @param env environment for calling thread
 	 */
-	void postMarkProcessing(MM_EnvironmentBase *env) {}
+	void postMarkProcessing(MM_EnvironmentBase *env);
 
 	/**
 	 * Called on GC master thread near the end of a global collection. This is informational,
@@ -26,6 +26,10 @@
 
 #if defined(OMR_GC_SEGREGATED_HEAP)
 
+#include <Splash/Arrays.hpp>
+
+#include <assert.h>
+
 typedef struct LanguageSegregatedAllocationCacheEntryStruct {
 	uintptr_t* current;
 	uintptr_t* top;
@@ -37,7 +41,50 @@ class MM_LanguageSegregatedAllocationCache {
 
 	LanguageSegregatedAllocationCache _languageSegregatedAllocationCache;
 
+	/**
+	 * Fill in the cell sizes of the SMALL_SIZECLASSES table, and the index mapping
+	 * each small size to the smallest class that fits it. The number of cells per
+	 * region depends on the region size, and is left to the configuration.
+	 */
+	static void
+	initializeSizeClasses(OMR_SizeClasses *sizeClasses)
+	{
+		const uintptr_t cellSizes[] = SMALL_SIZECLASSES;
+		uintptr_t sizeClass = OMR_SIZECLASSES_MIN_SMALL;
+
+		for (uintptr_t i = 0; i <= OMR_SIZECLASSES_MAX_SMALL; i++) {
+			assert(0 == (cellSizes[i] % Splash::ALIGNMENT));
+			sizeClasses->smallCellSizes[i] = cellSizes[i];
+			sizeClasses->smallNumCells[i] = 0;
+		}
+
+		/* Entry i serves size (i << 2). Splash sizes are always aligned, so round up
+		 * to the aligned size covering it.
+		 */
+		for (uintptr_t i = 0; i < (OMR_SIZECLASSES_MAX_SMALL_SIZE_BYTES >> 2); i++) {
+			uintptr_t size = align(i << 2, Splash::ALIGNMENT);
+			while (cellSizes[sizeClass] < size) {
+				sizeClass += 1;
+			}
+			sizeClasses->sizeClassIndex[i] = sizeClass;
+		}
+	}
+
 public:
+	/**
+	 * The size classes of the segregated heap. They are shared by the configuration,
+	 * which hands them to OMR, and the inline Splash allocators, which use them to
+	 * pick a cache entry.
+	 */
+	static OMR_SizeClasses *
+	getSizeClasses()
+	{
+		static OMR_SizeClasses sizeClasses;
+		static bool initialized = (initializeSizeClasses(&sizeClasses), true);
+		(void)initialized;
+		return &sizeClasses;
+	}
+
 	MMINLINE LanguageSegregatedAllocationCacheEntryStruct *
 	getLanguageSegregatedAllocationCacheStruct(MM_EnvironmentBase *env)
 	{
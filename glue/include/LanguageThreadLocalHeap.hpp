@@ -35,6 +35,21 @@ typedef struct LanguageThreadLocalHeapStruct {
     void* memoryPool;
 } LanguageThreadLocalHeapStruct;
 
+/**
+ * Refresh statistics and adaptive sizing state for one TLH. Not maintained by OMR: the Splash
+ * allocators count refreshes around their out-of-line allocations, and the environment delegate
+ * picks a new refresh size from them before each GC.
+ */
+typedef struct LanguageThreadLocalHeapSizingStruct {
+    uintptr_t refreshCount; /* TLH refreshes since the thread attached */
+    uintptr_t refreshFailures; /* refreshes that left the thread without a TLH */
+    uintptr_t cycleRefreshes; /* refreshes since the last GC */
+    uintptr_t cycleFailures; /* refresh failures since the last GC */
+    uintptr_t cycleBytes; /* bytes of TLH handed to the thread since the last GC */
+    uintptr_t refreshSize; /* the refresh size chosen by the sizing policy, or 0 to leave OMR's */
+    intptr_t prefetchDistance; /* how far ahead of heapAlloc to prefetch, or 0 not to */
+} LanguageThreadLocalHeapSizingStruct;
+
 
 class MM_LanguageThreadLocalHeap {
 
@@ -51,6 +66,12 @@ private:
 	intptr_t nonZeroTlhPrefetchFTA;
 	intptr_t tlhPrefetchFTA;
 
+	/* The end of the cleared memory ahead of heapAlloc, for chunked zeroing. Not maintained by OMR. */
+	uint8_t* heapZeroed;
+
+	LanguageThreadLocalHeapSizingStruct nonZeroSizing;
+	LanguageThreadLocalHeapSizingStruct sizing;
+
 public:
 	LanguageThreadLocalHeapStruct* getLanguageThreadLocalHeapStruct(MM_EnvironmentBase* env, bool zeroTLH)
 	{
@@ -89,6 +110,25 @@ public:
 		return &tlhPrefetchFTA;
 	}
 
+	/**
+	 * The end of the memory known to be cleared in the zeroed TLH. Only meaningful when it lies
+	 * between heapAlloc and heapTop; the Splash allocators reset it whenever the TLH may have
+	 * been refreshed.
+	 */
+	uint8_t ** getPointerToHeapZeroed(MM_EnvironmentBase* env) {
+		return &heapZeroed;
+	}
+
+	LanguageThreadLocalHeapSizingStruct* getLanguageThreadLocalHeapSizingStruct(MM_EnvironmentBase* env, bool zeroTLH)
+	{
+#if defined(OMR_GC_NON_ZERO_TLH)
+		if (!zeroTLH) {
+			return &nonZeroSizing;
+		}
+#endif /* defined(OMR_GC_NON_ZERO_TLH) */
+		return &sizing;
+	}
+
 	MM_LanguageThreadLocalHeap() :
 		allocateThreadLocalHeap(),
 		nonZeroAllocateThreadLocalHeap(),
@@ -97,7 +137,10 @@ public:
 		nonZeroHeapTop(NULL),
 		heapTop(NULL),
 		nonZeroTlhPrefetchFTA(0),
-		tlhPrefetchFTA(0)
+		tlhPrefetchFTA(0),
+		heapZeroed(NULL),
+		nonZeroSizing(),
+		sizing()
 	{};
 
 };
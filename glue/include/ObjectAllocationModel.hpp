@@ -25,8 +25,14 @@
 #include "AllocateInitialization.hpp"
 #include "ObjectModel.hpp"
 
+#include <Splash/Arrays.hpp>
+
+#include <new>
+
 /**
- * Class definition for the Java object allocation model.
+ * Class definition for the Splash object allocation model. The experimental allocators
+ * initialize objects themselves; this model is only used for allocations that need
+ * allocation flags, such as objects allocated directly in tenure.
  */
 class MM_ObjectAllocationModel : public MM_AllocateInitialization
 {
@@ -40,7 +46,7 @@ public:
 	 * initialize the header of a newly allocated object.
 	 */
 	enum {
-		allocation_category_example
+		allocation_category_splash
 	};
 
 protected:
@@ -53,7 +59,8 @@ private:
 protected:
 public:
 	/**
-	 * Initializer.
+	 * Initializer. Gives the object a BinArray header covering the whole allocation, so the
+	 * heap stays walkable until the caller runs the real Splash initializer over it.
 	 */
 	MMINLINE omrobjectptr_t
 	initializeObject(MM_EnvironmentBase *env, void *allocatedBytes)
@@ -61,7 +68,8 @@ public:
 		omrobjectptr_t objectPtr = (omrobjectptr_t)allocatedBytes;
 
 		if (NULL != objectPtr) {
-			new(objectPtr) Object((ObjectSize)getAllocateDescription()->getBytesRequested()); 
+			uintptr_t size = getAllocateDescription()->getBytesRequested();
+			new(objectPtr) Splash::BinArray((std::uint32_t)(size - sizeof(Splash::BinArray)));
 		}
 
 		return objectPtr;
@@ -71,7 +79,7 @@ public:
 	 * Constructor.
 	 */
 	MM_ObjectAllocationModel(MM_EnvironmentBase *env,  uintptr_t requiredSizeInBytes, uintptr_t allocateObjectFlags = 0)
-		: MM_AllocateInitialization(env, allocation_category_example, requiredSizeInBytes, allocateObjectFlags)
+		: MM_AllocateInitialization(env, allocation_category_splash, requiredSizeInBytes, allocateObjectFlags)
 	{}
 };
 #endif /* OBJECTALLOCATIONMODEL_HPP_ */
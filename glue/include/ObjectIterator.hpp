@@ -32,6 +32,8 @@
 #include "ObjectModel.hpp"
 #include "SlotObject.hpp"
 
+#include <Splash/Arrays.hpp>
+
 
 class GC_ObjectIterator
 {
@@ -39,6 +41,7 @@ class GC_ObjectIterator
 private:
 protected:
 	GC_SlotObject _slotObject;	/**< Create own SlotObject class to provide output */
+	Splash::SlotLayout _layout;		/**< reference slots of the object */
 	fomrobject_t *_scanPtr;			/**< current scan pointer */
 	fomrobject_t *_endPtr;			/**< end scan pointer */
 public:
@@ -48,12 +51,10 @@ private:
 	MMINLINE void
 	initialize(OMR_VM *omrVM, omrobjectptr_t objectPtr)
 	{
-		/* Start _scanPtr after header */
-		_scanPtr = (fomrobject_t *)objectPtr + 1;
-
-		MM_GCExtensionsBase *extensions = (MM_GCExtensionsBase *)omrVM->_gcOmrVMExtensions;
-		uintptr_t size = extensions->objectModel.getConsumedSizeInBytesWithHeader(objectPtr);
-		_endPtr = (fomrobject_t *)((U_8*)objectPtr + size);
+		/* Only walk the reference slots: never the payload of a BinArray, or past the length of a RefArray */
+		_layout = Splash::slotLayout(objectPtr);
+		_scanPtr = (fomrobject_t *)_layout.begin;
+		_endPtr = (fomrobject_t *)_layout.end;
 	}
 
 protected:
@@ -65,10 +66,13 @@ public:
 	 */
 	MMINLINE GC_SlotObject *nextSlot()
 	{
-		if (_scanPtr < _endPtr) {
-			_slotObject.writeAddressToSlot(_scanPtr);
+		while (_scanPtr < _endPtr) {
+			fomrobject_t *slot = _scanPtr;
 			_scanPtr += 1;
-			return &_slotObject;
+			if (_layout.isRef(slot - (fomrobject_t *)_layout.begin)) {
+				_slotObject.writeAddressToSlot(slot);
+				return &_slotObject;
+			}
 		}
 		return NULL;
 	}
@@ -88,6 +92,7 @@ public:
 	 */
 	GC_ObjectIterator(OMR_VM *omrVM, omrobjectptr_t objectPtr)
 		: _slotObject(GC_SlotObject(omrVM, NULL))
+		, _layout()
 		, _scanPtr(NULL)
 		, _endPtr(NULL)
 	{
@@ -23,6 +23,7 @@
 #define OBJECTSCANNERSTATE_HPP_
 
 #include "MixedObjectScanner.hpp"
+#include "SplashObjectScanner.hpp"
 
 /**
  * This union is not intended for runtime usage -- it is required only to determine the maximal size of
@@ -33,6 +34,7 @@
 typedef union GC_ObjectScannerState
 {
 	uint8_t scanner[sizeof(GC_MixedObjectScanner)];
+	uint8_t splashScanner[sizeof(GC_SplashObjectScanner)];
 } GC_ObjectScannerState;
 
 #endif /* OBJECTSCANNERSTATE_HPP_ */
@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * Copyright (c) 2014, 2016 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#if !defined(SPLASHOBJECTSCANNER_HPP_)
+#define SPLASHOBJECTSCANNER_HPP_
+
+#include "omrcfg.h"
+#include "ModronAssertions.h"
+#include "modronbase.h"
+
+#include "EnvironmentBase.hpp"
+#include "objectdescription.h"
+#include "ObjectScanner.hpp"
+
+#include <Splash/Arrays.hpp>
+
+/**
+ * Array-aware object scanner for builds without OMR_GC_EXPERIMENTAL_OBJECT_SCANNER. The reference
+ * slots of each object are found from its Splash::Kind: the payloads of BinArrays and typed arrays are
+ * never scanned, scanning stops at the length of a RefArray or Spine, and only the words marked in the
+ * refMap of a Record or ValueArray are scanned.
+ */
+class GC_SplashObjectScanner : public GC_ObjectScanner
+{
+	/* Data Members */
+private:
+	Splash::SlotLayout _layout;	/**< reference slots of the object being scanned */
+	fomrobject_t *_mapPtr;		/**< first slot of the current scan map */
+
+protected:
+
+public:
+
+	/* Member Functions */
+private:
+	/**
+	 * Build the scan map for the slots starting at mapPtr. Bit i is set if slot mapPtr + i holds a reference.
+	 */
+	MMINLINE uintptr_t
+	getScanMap(fomrobject_t *mapPtr)
+	{
+		fomrobject_t *endPtr = (fomrobject_t *)_layout.end;
+		intptr_t remainder = endPtr - mapPtr;
+		uintptr_t count = (remainder < _bitsPerScanMap) ? (uintptr_t)remainder : (uintptr_t)_bitsPerScanMap;
+
+		if (0 == _layout.stride) {
+			/* every slot is a reference */
+			return (count < (uintptr_t)_bitsPerScanMap) ? ((((uintptr_t)1) << count) - 1) : UINTPTR_MAX;
+		}
+
+		uintptr_t scanMap = 0;
+		uintptr_t first = mapPtr - (fomrobject_t *)_layout.begin;
+		for (uintptr_t i = 0; i < count; i++) {
+			if (_layout.isRef(first + i)) {
+				scanMap |= ((uintptr_t)1) << i;
+			}
+		}
+		return scanMap;
+	}
+
+protected:
+	/**
+	 * @param env The scanning thread environment
+	 * @param objectPtr the object to be processed
+	 * @param flags Scanning context flags
+	 */
+	MMINLINE GC_SplashObjectScanner(MM_EnvironmentBase *env, omrobjectptr_t objectPtr, uintptr_t flags)
+		: GC_ObjectScanner(env, (fomrobject_t *)Splash::slotLayout(objectPtr).begin, 0, flags)
+		, _layout(Splash::slotLayout(objectPtr))
+		, _mapPtr(_scanPtr)
+	{
+		_typeId = __FUNCTION__;
+	}
+
+	/**
+	 * Set up the scan map for the first slots of the object.
+	 * @param[in] env The scanning thread environment
+	 */
+	MMINLINE void
+	initialize(MM_EnvironmentBase *env)
+	{
+		GC_ObjectScanner::initialize(env);
+
+		intptr_t slotCount = (fomrobject_t *)_layout.end - _scanPtr;
+		if (0 < slotCount) {
+			_scanMap = getScanMap(_scanPtr);
+		}
+		if (slotCount <= _bitsPerScanMap) {
+			setNoMoreSlots();
+		}
+	}
+
+public:
+	/**
+	 * In-place instantiation and initialization for array-aware object scanner.
+	 * @param[in] env The scanning thread environment
+	 * @param[in] objectPtr The object to scan
+	 * @param[in] allocSpace Pointer to space for in-place instantiation (at least sizeof(GC_SplashObjectScanner) bytes)
+	 * @param[in] flags Scanning context flags
+	 * @return Pointer to GC_SplashObjectScanner instance in allocSpace
+	 */
+	MMINLINE static GC_SplashObjectScanner *
+	newInstance(MM_EnvironmentBase *env, omrobjectptr_t objectPtr, void *allocSpace, uintptr_t flags)
+	{
+		GC_SplashObjectScanner *objectScanner = (GC_SplashObjectScanner *)allocSpace;
+		new(objectScanner) GC_SplashObjectScanner(env, objectPtr, flags);
+		objectScanner->initialize(env);
+		return objectScanner;
+	}
+
+	/**
+	 * Return the scan map for the next run of slots, and the first slot it covers.
+	 * @param[out] slotMap the next scan map
+	 * @param[out] hasNextSlotMap true if another scan map follows this one
+	 * @return the first slot covered by slotMap, or NULL if there are no more slots
+	 */
+	virtual fomrobject_t *
+	getNextSlotMap(uintptr_t *slotMap, bool *hasNextSlotMap)
+	{
+		fomrobject_t *result = NULL;
+		fomrobject_t *endPtr = (fomrobject_t *)_layout.end;
+
+		*slotMap = 0;
+		*hasNextSlotMap = false;
+		_mapPtr += _bitsPerScanMap;
+		if (endPtr > _mapPtr) {
+			*slotMap = getScanMap(_mapPtr);
+			*hasNextSlotMap = (endPtr - _mapPtr) > _bitsPerScanMap;
+			result = _mapPtr;
+		}
+		return result;
+	}
+};
+
+#endif /* SPLASHOBJECTSCANNER_HPP_ */
@@ -38,6 +38,9 @@ class MM_StartupManagerImpl : public MM_StartupManager
 private:
 
 protected:
+#if defined(OMR_GC_MODRON_SCAVENGER)
+	bool _useGenerationalGC;
+#endif /* defined(OMR_GC_MODRON_SCAVENGER) */
 #if defined(OMR_GC_SEGREGATED_HEAP)
 	bool _useSegregatedGC;
 #endif /* defined(OMR_GC_SEGREGATED_HEAP) */
@@ -62,6 +65,9 @@ public:
 
 	MM_StartupManagerImpl(OMR_VM *omrVM)
 		: MM_StartupManager(omrVM, defaultMinimumHeapSize, defaultMaximumHeapSize)
+#if defined(OMR_GC_MODRON_SCAVENGER)
+		, _useGenerationalGC(true)
+#endif /* defined(OMR_GC_MODRON_SCAVENGER) */
 #if defined(OMR_GC_SEGREGATED_HEAP)
 		, _useSegregatedGC(false)
 #endif /* defined(OMR_GC_SEGREGATED_HEAP) */
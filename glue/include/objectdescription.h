@@ -33,7 +33,12 @@ typedef OMRClient::GC::ObjectRef languageobjectptr_t;  // object reference, used
 typedef OMRClient::GC::ObjectRef omrobjectptr_t;       // object reference, used by OMR internally
 typedef OMRClient::GC::ObjectRef omrarrayptr_t;        // array reference, used by OMR internally
 
+#if defined(OMR_GC_COMPRESSED_POINTERS)
+typedef uint32_t fomrobject_t;    // object-reference field in object
+typedef uint32_t fomrarray_t;     // array-reference field in object or array
+#else /* OMR_GC_COMPRESSED_POINTERS */
 typedef uintptr_t fomrobject_t;   // object-reference field in object
 typedef uintptr_t fomrarray_t;    // array-reference field in object or array
+#endif /* OMR_GC_COMPRESSED_POINTERS */
 
 #endif /* OBJECTDESCRIPTION_H_ */
@@ -57,9 +57,13 @@
  * Note that this array must be of size OMR_SIZECLASSES_NUM_SMALL+1. Note that
  * the 0 size class isn't used since there are no 0-size objects.
  *
- * Trivial example below admits 15 allocation sizes up to 2k.
+ * Splash objects are always a multiple of 16 bytes (Splash::ALIGNMENT), so every
+ * class is too, and every cell stays 16 byte aligned. Small buffers get one class
+ * per aligned size up to 64 bytes. BinArray and RefArray sizes up to 1k are spread
+ * evenly, so from 256 bytes up to 1k the classes are 128 bytes apart, and no cell
+ * wastes more than 112 bytes.
  */
-#define SMALL_SIZECLASSES	{ 0, 16, 32, 64, 96, 160, 240, 352, 456, 592, 760, 968, 1200, 1520, 1760, 2048 }
+#define SMALL_SIZECLASSES	{ 0, 16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 640, 768, 896, 1024, 2048 }
 
 typedef struct OMR_SizeClasses {
     uintptr_t smallCellSizes[OMR_SIZECLASSES_MAX_SMALL + 1];
@@ -48,8 +48,8 @@
 #include "Scavenger.hpp"
 
 #if !defined(OMR_GC_EXPERIMENTAL_OBJECT_SCANNER)
-#include "MixedObjectScanner.hpp"
 #include "SlotObject.hpp"
+#include "SplashObjectScanner.hpp"
 #include "ObjectIterator.hpp"
 #endif /* !defined(OMR_GC_EXPERIMENTAL_OBJECT_SCANNER) */
 
@@ -104,25 +104,69 @@ MM_CollectorLanguageInterfaceImpl::scavenger_masterSetupForGC(MM_EnvironmentBase
 void
 MM_CollectorLanguageInterfaceImpl::scavenger_workerSetupForGC_clearEnvironmentLangStats(MM_EnvironmentBase *env)
 {
-	/* Do nothing for now */
+	GC_Environment *gcEnv = env->getGCEnvironment();
+	memset(gcEnv->siteSurvivedBytes, 0, sizeof(gcEnv->siteSurvivedBytes));
 }
 
 void
 MM_CollectorLanguageInterfaceImpl::scavenger_reportScavengeEnd(MM_EnvironmentBase * envBase, bool scavengeSuccessful)
 {
-	/* Do nothing for now */
+	GC_ObjectModelDelegate *objectModelDelegate = _extensions->objectModel.getObjectModelDelegate();
+	uintptr_t pretenuredBytes = objectModelDelegate->resetPretenuredBytes();
+
+	if (scavengeSuccessful) {
+		/* Pretenure the allocation sites whose objects survived this scavenge. */
+		objectModelDelegate->getAllocationSites()->update();
+	} else {
+		objectModelDelegate->getAllocationSites()->discardSurvived();
+	}
+
+	if (UINTPTR_MAX != objectModelDelegate->getPretenureThreshold()) {
+		/* Objects allocated directly in tenure since the last scavenge. This scavenge did not have
+		 * to copy any of them.
+		 */
+		OMRPORT_ACCESS_FROM_OMRPORT(envBase->getPortLibrary());
+		omrtty_printf("<scavenge pretenured=\"%zu\" />\n", (size_t)pretenuredBytes);
+	}
 }
 
 void
 MM_CollectorLanguageInterfaceImpl::scavenger_mergeGCStats_mergeLangStats(MM_EnvironmentBase *envBase)
 {
-	/* Do nothing for now */
+	GC_Environment *gcEnv = envBase->getGCEnvironment();
+	OMRClient::GC::AllocationSites *sites = _extensions->objectModel.getObjectModelDelegate()->getAllocationSites();
+
+	for (uintptr_t site = 0; site < Splash::SITE_COUNT; site++) {
+		if (0 != gcEnv->siteSurvivedBytes[site]) {
+			sites->addSurvived((Splash::Site)site, gcEnv->siteSurvivedBytes[site]);
+		}
+	}
 }
 
 void
 MM_CollectorLanguageInterfaceImpl::scavenger_masterThreadGarbageCollect_scavengeComplete(MM_EnvironmentBase *envBase)
 {
-	/* Do nothing for now */
+	if (_extensions->isScavengerBackOutFlagRaised()) {
+		/* The scavenge was backed out: every object is back where it was. */
+		return;
+	}
+
+	/* External arrays left in evacuate space were not copied, so they are dead. Follow the ones
+	 * that were copied. This runs before the evacuate space is reused, so the forwarded headers
+	 * are still intact.
+	 */
+	MM_Scavenger *scavenger = _extensions->scavenger;
+	_extensions->objectModel.getObjectModelDelegate()->getExternalArrays()->sweep([scavenger](Splash::ExternalBinArray *array) {
+		omrobjectptr_t object = (omrobjectptr_t)array;
+		if (!scavenger->isObjectInEvacuateMemory(object)) {
+			return array;
+		}
+		MM_ForwardedHeader forwardedHeader(object);
+		if (forwardedHeader.isForwardedPointer()) {
+			return (Splash::ExternalBinArray *)forwardedHeader.getForwardedObject();
+		}
+		return (Splash::ExternalBinArray *)NULL;
+	});
 }
 
 void
@@ -146,7 +190,7 @@ MM_CollectorLanguageInterfaceImpl::scavenger_getObjectScanner(MM_EnvironmentStan
 	Assert_MM_true((GC_ObjectScanner::scanHeap == flags) ^ (GC_ObjectScanner::scanRoots == flags));
 #endif /* defined(OMR_GC_MODRON_SCAVENGER_STRICT) */
 	GC_ObjectScanner *objectScanner = NULL;
-	objectScanner = GC_MixedObjectScanner::newInstance(env, objectPtr, allocSpace, flags);
+	objectScanner = GC_SplashObjectScanner::newInstance(env, objectPtr, allocSpace, flags);
 	return objectScanner;
 }
 #endif // !defined(OMR_GC_EXPERIMENTAL_OBJECT_SCANNER)
@@ -0,0 +1,149 @@
+/*******************************************************************************
+ * Copyright (c) 1991, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "omrcfg.h"
+
+#include "EnvironmentBase.hpp"
+#include "EnvironmentDelegate.hpp"
+#include "GCExtensionsBase.hpp"
+#include "LanguageThreadLocalHeap.hpp"
+#include "ObjectModel.hpp"
+
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+
+/**
+ * Choose the refresh size and prefetch distance of one TLH for the next GC cycle, from the
+ * refreshes counted by the Splash allocators during the cycle that is ending.
+ */
+static void
+updateTLHSizing(MM_EnvironmentBase *env, bool zeroTLH)
+{
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+	OMRClient::GC::TLHSizing *policy = extensions->objectModel.getObjectModelDelegate()->getTLHSizing();
+	MM_LanguageThreadLocalHeap *tlh = env->getLanguageThreadLocalHeap();
+	LanguageThreadLocalHeapSizingStruct *sizing = tlh->getLanguageThreadLocalHeapSizingStruct(env, zeroTLH);
+
+	if (policy->isEnabled()) {
+		uintptr_t current = sizing->refreshSize;
+		if (0 == current) {
+			current = tlh->getLanguageThreadLocalHeapStruct(env, zeroTLH)->refreshSize;
+		}
+		if (0 == current) {
+			current = extensions->tlhInitialSize;
+		}
+		sizing->refreshSize = policy->nextRefreshSize(current, sizing->cycleBytes, sizing->cycleFailures,
+			extensions->tlhMinimumSize, extensions->tlhMaximumSize);
+		sizing->prefetchDistance = (intptr_t)policy->nextPrefetchDistance(sizing->cycleBytes, extensions->tlhMaximumSize);
+	}
+
+	sizing->cycleRefreshes = 0;
+	sizing->cycleFailures = 0;
+	sizing->cycleBytes = 0;
+}
+
+#endif /* OMR_GC_THREAD_LOCAL_HEAP */
+
+void
+MM_EnvironmentDelegate::flushNonAllocationCaches()
+{
+	/* Hand this thread's allocation site counts to the collector before the GC starts. */
+	OMRClient::GC::AllocationSites *sites = _env->getExtensions()->objectModel.getObjectModelDelegate()->getAllocationSites();
+	for (uintptr_t site = 0; site < Splash::SITE_COUNT; site++) {
+		if (0 != _gcEnv.siteAllocatedBytes[site]) {
+			sites->addAllocated((Splash::Site)site, _gcEnv.siteAllocatedBytes[site]);
+			_gcEnv.siteAllocatedBytes[site] = 0;
+		}
+	}
+
+	_gcEnv.gcCount += 1;
+
+	/* Objects in an open region may be moved, or found reachable, by this GC. Never reclaim it. */
+	if (0 != _gcEnv.regionDepth) {
+		_gcEnv.regionEscaped = true;
+	}
+
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+	/* Resize this thread's TLHs for the next cycle. */
+	updateTLHSizing(_env, true);
+#if defined(OMR_GC_NON_ZERO_TLH)
+	updateTLHSizing(_env, false);
+#endif /* defined(OMR_GC_NON_ZERO_TLH) */
+#endif /* OMR_GC_THREAD_LOCAL_HEAP */
+}
+
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+
+/**
+ * Hide the allocation pointer of one TLH, so that it looks full to inline allocators.
+ */
+static void
+disableInlineTLHAllocate(MM_EnvironmentBase *env, bool zeroTLH)
+{
+	MM_LanguageThreadLocalHeap *tlh = env->getLanguageThreadLocalHeap();
+	LanguageThreadLocalHeapStruct *tlhStruct = tlh->getLanguageThreadLocalHeapStruct(env, zeroTLH);
+	uint8_t **heapAlloc = tlh->getPointerToHeapAlloc(env, zeroTLH);
+	if (NULL == tlhStruct->realHeapAlloc) {
+		tlhStruct->realHeapAlloc = *heapAlloc;
+		*heapAlloc = *tlh->getPointerToHeapTop(env, zeroTLH);
+	}
+}
+
+/**
+ * Restore the allocation pointer of one TLH hidden by disableInlineTLHAllocate().
+ */
+static void
+enableInlineTLHAllocate(MM_EnvironmentBase *env, bool zeroTLH)
+{
+	MM_LanguageThreadLocalHeap *tlh = env->getLanguageThreadLocalHeap();
+	LanguageThreadLocalHeapStruct *tlhStruct = tlh->getLanguageThreadLocalHeapStruct(env, zeroTLH);
+	if (NULL != tlhStruct->realHeapAlloc) {
+		*tlh->getPointerToHeapAlloc(env, zeroTLH) = tlhStruct->realHeapAlloc;
+		tlhStruct->realHeapAlloc = NULL;
+	}
+}
+
+void
+MM_EnvironmentDelegate::disableInlineTLHAllocate()
+{
+	::disableInlineTLHAllocate(_env, true);
+#if defined(OMR_GC_NON_ZERO_TLH)
+	::disableInlineTLHAllocate(_env, false);
+#endif /* defined(OMR_GC_NON_ZERO_TLH) */
+}
+
+void
+MM_EnvironmentDelegate::enableInlineTLHAllocate()
+{
+	::enableInlineTLHAllocate(_env, true);
+#if defined(OMR_GC_NON_ZERO_TLH)
+	::enableInlineTLHAllocate(_env, false);
+#endif /* defined(OMR_GC_NON_ZERO_TLH) */
+}
+
+bool
+MM_EnvironmentDelegate::isInlineTLHAllocateEnabled()
+{
+	MM_LanguageThreadLocalHeap *tlh = _env->getLanguageThreadLocalHeap();
+	return NULL == tlh->getLanguageThreadLocalHeapStruct(_env, true)->realHeapAlloc;
+}
+
+#endif /* OMR_GC_THREAD_LOCAL_HEAP */
@@ -20,3 +20,17 @@
  *******************************************************************************/
 
 #include "GlobalCollectorDelegate.hpp"
+
+#include "GCExtensionsBase.hpp"
+#include "MarkingScheme.hpp"
+#include "ObjectModel.hpp"
+
+void
+MM_GlobalCollectorDelegate::postMarkProcessing(MM_EnvironmentBase *env)
+{
+	/* External arrays that were not marked are dead: release their payloads before they are swept. */
+	MM_MarkingScheme *markingScheme = _markingScheme;
+	_extensions->objectModel.getObjectModelDelegate()->getExternalArrays()->sweep([markingScheme](Splash::ExternalBinArray *array) {
+		return markingScheme->isMarked((omrobjectptr_t)array) ? array : (Splash::ExternalBinArray *)NULL;
+	});
+}
@@ -20,7 +20,9 @@
  *******************************************************************************/
 
 #include "EnvironmentBase.hpp"
+#include "EnvironmentDelegate.hpp"
 #include "GCExtensionsBase.hpp"
+#include "ObjectAllocationModel.hpp"
 #include "ObjectModel.hpp"
 
 #include <cstdio>
@@ -29,8 +31,9 @@
 omrobjectptr_t
 GC_ObjectModelDelegate::initializeAllocation(MM_EnvironmentBase *env, void *allocatedBytes, MM_AllocateInitialization *allocateInitialization)
 {
-	assert(0);
-	return nullptr;
+	assert(MM_ObjectAllocationModel::allocation_category_splash == allocateInitialization->getAllocationCategory());
+	MM_ObjectAllocationModel *objectAllocationModel = (MM_ObjectAllocationModel *)allocateInitialization;
+	return objectAllocationModel->initializeObject(env, allocatedBytes);
 }
 
 #if defined(OMR_GC_MODRON_SCAVENGER)
@@ -38,8 +41,18 @@ void
 GC_ObjectModelDelegate::calculateObjectDetailsForCopy(MM_EnvironmentBase *env, MM_ForwardedHeader *forwardedHeader, uintptr_t *objectCopySizeInBytes, uintptr_t *reservedObjectSizeInBytes, uintptr_t *hotFieldAlignmentDescriptor)
 {
 
-	*objectCopySizeInBytes = getForwardedObjectSizeInBytes(forwardedHeader);
+	Splash::ArrayHeader header = getPreservedHeader(forwardedHeader);
+
+	*objectCopySizeInBytes = Splash::size(header);
 	*reservedObjectSizeInBytes = env->getExtensions()->objectModel.adjustSizeInBytes(*objectCopySizeInBytes);
 	*hotFieldAlignmentDescriptor = 0;
+
+	/* Count each object in the first scavenge it survives, when it still has age 0, so that survival is
+	 * measured against the bytes allocated since the last scavenge. Later copies within survivor space
+	 * only age the object. Merged into the allocation sites at the end of the scavenge.
+	 */
+	if ((Splash::NO_SITE != header.site()) && (0 == env->getExtensions()->objectModel.getPreservedAge(forwardedHeader))) {
+		env->getGCEnvironment()->siteSurvivedBytes[header.site()] += *objectCopySizeInBytes;
+	}
 }
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) */
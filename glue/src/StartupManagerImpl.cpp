@@ -33,17 +33,54 @@
 
 #include "StartupManagerImpl.hpp"
 
+#include <Splash/Arrays.hpp>
+
+#include <stdlib.h>
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+#define OMR_GENCON "-Xgcpolicy:gencon"
+#define OMR_OPTTHRUPUT "-Xgcpolicy:optthruput"
+#endif /* defined(OMR_GC_MODRON_SCAVENGER) */
+
 #if defined(OMR_GC_SEGREGATED_HEAP)
 #define OMR_SEGREGATEDHEAP "-Xgcpolicy:segregated"
 #define OMR_SEGREGATEDHEAP_LENGTH 21
 #endif /* defined(OMR_GC_SEGREGATED_HEAP) */
 
+#define SPLASH_SCANPREFETCH "-XscanPrefetch:"
+#define SPLASH_SCANPREFETCH_LENGTH 15
+
+#define SPLASH_PRETENURETHRESHOLD "-XpretenureThreshold:"
+#define SPLASH_PRETENURETHRESHOLD_LENGTH 21
+
+#define SPLASH_SITESURVIVAL "-XsiteSurvival:"
+#define SPLASH_SITESURVIVAL_LENGTH 15
+
+#define SPLASH_ZEROSTRATEGY "-XzeroStrategy:"
+#define SPLASH_ZEROSTRATEGY_LENGTH 15
+
+#define SPLASH_TLHSIZING "-XtlhSizing:"
+#define SPLASH_TLHSIZING_LENGTH 12
+
+#define SPLASH_TLHPREFETCH "-XtlhPrefetch:"
+#define SPLASH_TLHPREFETCH_LENGTH 14
+
 bool
 MM_StartupManagerImpl::handleOption(MM_GCExtensionsBase *extensions, char *option)
 {
 	bool result = MM_StartupManager::handleOption(extensions, option);
 
 	if (!result) {
+#if defined(OMR_GC_MODRON_SCAVENGER)
+		if (0 == strcmp(option, OMR_GENCON)) {
+			_useGenerationalGC = true;
+			result = true;
+		}
+		if (0 == strcmp(option, OMR_OPTTHRUPUT)) {
+			_useGenerationalGC = false;
+			result = true;
+		}
+#endif /* defined(OMR_GC_MODRON_SCAVENGER) */
 #if defined(OMR_GC_SEGREGATED_HEAP)
 		if (0 == strncmp(option, OMR_SEGREGATEDHEAP, OMR_SEGREGATEDHEAP_LENGTH)) {
 			/* OMRTODO: when we have a flag in extensions to use a segregated heap,
@@ -53,6 +90,73 @@ MM_StartupManagerImpl::handleOption(MM_GCExtensionsBase *extensions, char *optio
 			result = true;
 		}
 #endif /* defined(OMR_GC_SEGREGATED_HEAP) */
+		if (0 == strncmp(option, SPLASH_SCANPREFETCH, SPLASH_SCANPREFETCH_LENGTH)) {
+			/* -XscanPrefetch:<n> prefetches referents n slots ahead of the scan. 0 disables prefetching. */
+			char *value = option + SPLASH_SCANPREFETCH_LENGTH;
+			char *end = NULL;
+			uintptr_t distance = (uintptr_t)strtoul(value, &end, 10);
+			if ((end != value) && ('\0' == *end)) {
+				extensions->objectModel.getObjectModelDelegate()->setScanPrefetchDistance(distance);
+				result = true;
+			}
+		}
+		if (0 == strncmp(option, SPLASH_PRETENURETHRESHOLD, SPLASH_PRETENURETHRESHOLD_LENGTH)) {
+			/* -XpretenureThreshold:<bytes> allocates objects of at least <bytes> directly in tenure. */
+			char *value = option + SPLASH_PRETENURETHRESHOLD_LENGTH;
+			char *end = NULL;
+			uintptr_t threshold = (uintptr_t)strtoul(value, &end, 10);
+			if ((end != value) && ('\0' == *end) && (0 != threshold)) {
+				extensions->objectModel.getObjectModelDelegate()->setPretenureThreshold(threshold);
+				result = true;
+			}
+		}
+		if (0 == strncmp(option, SPLASH_SITESURVIVAL, SPLASH_SITESURVIVAL_LENGTH)) {
+			/* -XsiteSurvival:<percent> pretenures allocation sites once <percent> of their bytes survive. 0 disables. */
+			char *value = option + SPLASH_SITESURVIVAL_LENGTH;
+			char *end = NULL;
+			uintptr_t percent = (uintptr_t)strtoul(value, &end, 10);
+			if ((end != value) && ('\0' == *end)) {
+				extensions->objectModel.getObjectModelDelegate()->getAllocationSites()->setSurvivalThreshold(percent);
+				result = true;
+			}
+		}
+		if (0 == strncmp(option, SPLASH_ZEROSTRATEGY, SPLASH_ZEROSTRATEGY_LENGTH)) {
+			/* -XzeroStrategy:object|chunked|streaming selects how zeroed objects are cleared. */
+			char *value = option + SPLASH_ZEROSTRATEGY_LENGTH;
+			GC_ObjectModelDelegate *delegate = extensions->objectModel.getObjectModelDelegate();
+			if (0 == strcmp(value, "object")) {
+				delegate->setZeroingStrategy(Splash::ZeroingStrategy::OBJECT);
+				result = true;
+			} else if (0 == strcmp(value, "chunked")) {
+				delegate->setZeroingStrategy(Splash::ZeroingStrategy::CHUNKED);
+				result = true;
+			} else if (0 == strcmp(value, "streaming")) {
+				delegate->setZeroingStrategy(Splash::ZeroingStrategy::STREAMING);
+				result = true;
+			}
+		}
+		if (0 == strncmp(option, SPLASH_TLHSIZING, SPLASH_TLHSIZING_LENGTH)) {
+			/* -XtlhSizing:adaptive|fixed selects whether TLH refresh sizes follow each thread's allocation rate. */
+			char *value = option + SPLASH_TLHSIZING_LENGTH;
+			OMRClient::GC::TLHSizing *sizing = extensions->objectModel.getObjectModelDelegate()->getTLHSizing();
+			if (0 == strcmp(value, "adaptive")) {
+				sizing->setEnabled(true);
+				result = true;
+			} else if (0 == strcmp(value, "fixed")) {
+				sizing->setEnabled(false);
+				result = true;
+			}
+		}
+		if (0 == strncmp(option, SPLASH_TLHPREFETCH, SPLASH_TLHPREFETCH_LENGTH)) {
+			/* -XtlhPrefetch:<bytes> prefetches <bytes> ahead of the TLH of heavily allocating threads. 0 disables. */
+			char *value = option + SPLASH_TLHPREFETCH_LENGTH;
+			char *end = NULL;
+			uintptr_t distance = (uintptr_t)strtoul(value, &end, 10);
+			if ((end != value) && ('\0' == *end)) {
+				extensions->objectModel.getObjectModelDelegate()->getTLHSizing()->setPrefetchDistance(distance);
+				result = true;
+			}
+		}
 	}
 
 	return result;
@@ -80,8 +184,24 @@ MM_StartupManagerImpl::getOptions(void)
 MM_Configuration *
 MM_StartupManagerImpl::createConfiguration(MM_EnvironmentBase *env)
 {
+#if defined(OMR_GC_COMPRESSED_POINTERS)
+	/* The collector must decode slots exactly as Splash::decompress does. */
+	env->getOmrVM()->_compressedPointersShift = Splash::COMPRESSED_REF_SHIFT;
+#endif /* defined(OMR_GC_COMPRESSED_POINTERS) */
 #if defined(OMR_GC_MODRON_SCAVENGER)
 	MM_GCExtensionsBase *ext = MM_GCExtensionsBase::getExtensions(env->getOmrVM());
+	/* A build with the scavenger is a gencon build: use it unless -Xgcpolicy:optthruput was given. */
+	ext->scavengerEnabled = _useGenerationalGC;
+#if defined(OMR_GC_SEGREGATED_HEAP)
+	if (_useSegregatedGC) {
+		/* The segregated heap has no nursery. */
+		ext->scavengerEnabled = false;
+	}
+#endif /* defined(OMR_GC_SEGREGATED_HEAP) */
+	if (!ext->scavengerEnabled) {
+		/* Without a nursery, every object is allocated in tenure anyway. */
+		ext->objectModel.getObjectModelDelegate()->setPretenureThreshold(UINTPTR_MAX);
+	}
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) */
 #if defined(OMR_GC_SEGREGATED_HEAP)
 	if (_useSegregatedGC) {
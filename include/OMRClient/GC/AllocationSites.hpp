@@ -0,0 +1,127 @@
+/*******************************************************************************
+ *  Copyright (c) 2018, 2018 IBM and others
+ *
+ *  This program and the accompanying materials are made available under
+ *  the terms of the Eclipse Public License 2.0 which accompanies this
+ *  distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ *  or the Apache License, Version 2.0 which accompanies this distribution and
+ *  is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  This Source Code may also be made available under the following
+ *  Secondary Licenses when the conditions for such availability set
+ *  forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ *  General Public License, version 2 with the GNU Classpath
+ *  Exception [1] and GNU General Public License, version 2 with the
+ *  OpenJDK Assembly Exception [2].
+ *
+ *  [1] https://www.gnu.org/software/classpath/license.html
+ *  [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ *  SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(OMRCLIENT_GC_ALLOCATIONSITES_HPP_)
+#define OMRCLIENT_GC_ALLOCATIONSITES_HPP_
+
+#include <Splash/Arrays.hpp>
+
+#include "AtomicSupport.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OMRClient {
+namespace GC {
+
+/// Survival feedback for Splash allocation sites.
+///
+/// Mutators count the bytes they allocate at each site, and the scavenger counts the bytes
+/// it copies. At the end of each scavenge, a site whose copied bytes reach the survival
+/// threshold, as a percentage of its allocated bytes, is pretenured: from then on its
+/// objects are allocated directly in tenure. Pretenuring is never undone, since objects
+/// allocated in tenure give no more survival feedback.
+class AllocationSites {
+public:
+	/// The default survival threshold, in percent.
+	static constexpr std::uintptr_t DEFAULT_SURVIVAL_THRESHOLD = 90;
+
+	/// Scavenges a site must have allocated in before it can be pretenured.
+	static constexpr std::uintptr_t MINIMUM_OBSERVATIONS = 2;
+
+	AllocationSites() : survivalThreshold_(DEFAULT_SURVIVAL_THRESHOLD) {
+		for (std::size_t site = 0; site < Splash::SITE_COUNT; ++site) {
+			allocatedBytes_[site] = 0;
+			survivedBytes_[site] = 0;
+			allocatedHistory_[site] = 0;
+			survivedHistory_[site] = 0;
+			observations_[site] = 0;
+			pretenured_[site] = false;
+		}
+	}
+
+	/// True if objects allocated at site go directly to tenure.
+	bool isPretenured(Splash::Site site) const { return pretenured_[site]; }
+
+	/// Set the survival threshold, in percent. 0 disables site pretenuring.
+	void setSurvivalThreshold(std::uintptr_t percent) { survivalThreshold_ = percent; }
+
+	std::uintptr_t getSurvivalThreshold() const { return survivalThreshold_; }
+
+	/// Add bytes allocated by one mutator. Called with exclusive VM access.
+	void addAllocated(Splash::Site site, std::uintptr_t bytes) { allocatedBytes_[site] += bytes; }
+
+	/// Add bytes copied by one scavenger thread.
+	void addSurvived(Splash::Site site, std::uintptr_t bytes) {
+		VM_AtomicSupport::add(&survivedBytes_[site], bytes);
+	}
+
+	/// Fold the counts of the scavenge that just ended into each site's history, and
+	/// pretenure the sites that survive. Older scavenges count for half as much as the
+	/// one after them. Returns the number of sites newly pretenured.
+	std::size_t update() {
+		std::size_t count = 0;
+		for (std::size_t site = 1; site < Splash::SITE_COUNT; ++site) {
+			if (allocatedBytes_[site] != 0) {
+				observations_[site] += 1;
+			}
+			// A thread that loses the race to copy an object has counted it too, so the
+			// survived bytes may slightly exceed the allocated bytes.
+			if (survivedBytes_[site] > allocatedBytes_[site]) {
+				survivedBytes_[site] = allocatedBytes_[site];
+			}
+			allocatedHistory_[site] = allocatedHistory_[site] / 2 + allocatedBytes_[site];
+			survivedHistory_[site] = survivedHistory_[site] / 2 + survivedBytes_[site];
+			allocatedBytes_[site] = 0;
+			survivedBytes_[site] = 0;
+
+			if (!pretenured_[site] && survivalThreshold_ != 0
+			    && observations_[site] >= MINIMUM_OBSERVATIONS
+			    && survivedHistory_[site] * 100 >= allocatedHistory_[site] * survivalThreshold_) {
+				pretenured_[site] = true;
+				count += 1;
+			}
+		}
+		return count;
+	}
+
+	/// Drop the bytes copied by a scavenge that failed, and was backed out.
+	void discardSurvived() {
+		for (std::size_t site = 0; site < Splash::SITE_COUNT; ++site) {
+			survivedBytes_[site] = 0;
+		}
+	}
+
+private:
+	std::uintptr_t allocatedBytes_[Splash::SITE_COUNT];
+	volatile std::uintptr_t survivedBytes_[Splash::SITE_COUNT];
+	std::uintptr_t allocatedHistory_[Splash::SITE_COUNT];
+	std::uintptr_t survivedHistory_[Splash::SITE_COUNT];
+	std::uintptr_t observations_[Splash::SITE_COUNT];
+	bool pretenured_[Splash::SITE_COUNT];
+	std::uintptr_t survivalThreshold_;
+};
+
+}  // namespace GC
+}  // namespace OMRClient
+
+#endif // OMRCLIENT_GC_ALLOCATIONSITES_HPP_
@@ -0,0 +1,98 @@
+/*******************************************************************************
+ *  Copyright (c) 2018, 2018 IBM and others
+ *
+ *  This program and the accompanying materials are made available under
+ *  the terms of the Eclipse Public License 2.0 which accompanies this
+ *  distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ *  or the Apache License, Version 2.0 which accompanies this distribution and
+ *  is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  This Source Code may also be made available under the following
+ *  Secondary Licenses when the conditions for such availability set
+ *  forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ *  General Public License, version 2 with the GNU Classpath
+ *  Exception [1] and GNU General Public License, version 2 with the
+ *  OpenJDK Assembly Exception [2].
+ *
+ *  [1] https://www.gnu.org/software/classpath/license.html
+ *  [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ *  SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(OMRCLIENT_GC_EXTERNALARRAYS_HPP_)
+#define OMRCLIENT_GC_EXTERNALARRAYS_HPP_
+
+#include <Splash/Arrays.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace OMRClient {
+namespace GC {
+
+/// The live ExternalBinArrays, whose payloads must be released when they die.
+///
+/// The registry holds its arrays weakly. After marking, and after each successful
+/// scavenge, the collector sweeps it: arrays that moved are updated, and the payloads of
+/// arrays that died are released. Each entry keeps its own copy of the payload, so the
+/// dead array itself is never read.
+class ExternalArrays {
+public:
+	ExternalArrays() : releasedBytes_(0) {}
+
+	/// Register a newly allocated array. Called by mutators, concurrently.
+	void add(Splash::ExternalBinArray* array) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		entries_.push_back({array, array->payload, array->nbytes, array->release});
+	}
+
+	/// Sweep the registry. locate is called with each array, and returns its current
+	/// address, or nullptr if it is dead. Called by the collector, with exclusive access.
+	/// Returns the number of payloads released.
+	template <typename Locate>
+	std::size_t sweep(Locate&& locate) {
+		std::size_t released = 0;
+		std::size_t kept = 0;
+		for (Entry& entry : entries_) {
+			Splash::ExternalBinArray* array = locate(entry.array);
+			if (array == nullptr) {
+				if (entry.release != nullptr) {
+					entry.release(entry.payload, entry.nbytes);
+				}
+				releasedBytes_ += entry.nbytes;
+				released += 1;
+			} else {
+				entry.array = array;
+				entries_[kept++] = entry;
+			}
+		}
+		entries_.resize(kept);
+		return released;
+	}
+
+	/// The number of arrays whose payloads have not been released.
+	std::size_t count() const { return entries_.size(); }
+
+	/// The total bytes of payload released so far.
+	std::uint64_t getReleasedBytes() const { return releasedBytes_; }
+
+private:
+	struct Entry {
+		Splash::ExternalBinArray* array;
+		std::uint8_t* payload;
+		std::uint64_t nbytes;
+		Splash::ReleaseFunction release;
+	};
+
+	std::mutex mutex_;
+	std::vector<Entry> entries_;
+	std::uint64_t releasedBytes_;
+};
+
+}  // namespace GC
+}  // namespace OMRClient
+
+#endif // OMRCLIENT_GC_EXTERNALARRAYS_HPP_
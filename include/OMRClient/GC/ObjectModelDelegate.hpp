@@ -25,10 +25,15 @@
 #include "omrcfg.h"
 
 #include <Splash/Arrays.hpp>
+#include <Splash/Zeroing.hpp>
 
+#include <OMRClient/GC/AllocationSites.hpp>
+#include <OMRClient/GC/ExternalArrays.hpp>
 #include <OMRClient/GC/ObjectScanner.hpp>
+#include <OMRClient/GC/TLHSizing.hpp>
 
 #include "objectdescription.h"
+#include "AtomicSupport.hpp"
 #include "ForwardedHeader.hpp"
 
 class MM_AllocateInitialization;
@@ -63,6 +68,43 @@ private:
 	static const uintptr_t _objectHeaderSlotFlagsShift = 0;
 	static const uintptr_t _objectHeaderSlotSizeShift = 8;
 
+	/**
+	 * The number of slots ahead of the slot being visited at which object scanners prefetch
+	 * referents. Zero disables prefetching. Set by the -XscanPrefetch: option.
+	 */
+	uintptr_t _scanPrefetchDistance;
+
+	/**
+	 * Objects of at least this many bytes are allocated directly in tenure, instead of in the
+	 * nursery. UINTPTR_MAX disables pretenuring. Set by the -XpretenureThreshold: option.
+	 */
+	uintptr_t _pretenureThreshold;
+
+	/**
+	 * The bytes allocated directly in tenure since the last scavenge.
+	 */
+	volatile uintptr_t _pretenuredBytes;
+
+	/**
+	 * Survival feedback for allocation sites, used to pretenure the sites whose objects survive.
+	 */
+	AllocationSites _allocationSites;
+
+	/**
+	 * How the Splash allocators clear zeroed objects. Set by the -XzeroStrategy: option.
+	 */
+	Splash::ZeroingStrategy _zeroingStrategy;
+
+	/**
+	 * The adaptive TLH sizing policy, applied to every thread before each GC.
+	 */
+	TLHSizing _tlhSizing;
+
+	/**
+	 * The live external arrays, whose payloads are released when they die.
+	 */
+	ExternalArrays _externalArrays;
+
 protected:
 public:
 
@@ -78,10 +120,89 @@ public:
 	MMINLINE OMRClient::GC::ObjectScanner
 	makeObjectScanner()
 	{
-		return OMRClient::GC::ObjectScanner();
+		return OMRClient::GC::ObjectScanner(_scanPrefetchDistance);
 	}
 #endif /* OMR_GC_EXPERIMENTAL_OBJECT_SCANNER */
 
+	/**
+	 * Set the distance, in slots, at which object scanners prefetch referents.
+	 */
+	MMINLINE void
+	setScanPrefetchDistance(uintptr_t distance)
+	{
+		_scanPrefetchDistance = distance;
+	}
+
+	MMINLINE uintptr_t
+	getScanPrefetchDistance()
+	{
+		return _scanPrefetchDistance;
+	}
+
+	/**
+	 * Set the size, in bytes, at or above which objects are allocated directly in tenure.
+	 */
+	MMINLINE void
+	setPretenureThreshold(uintptr_t threshold)
+	{
+		_pretenureThreshold = threshold;
+	}
+
+	MMINLINE uintptr_t
+	getPretenureThreshold()
+	{
+		return _pretenureThreshold;
+	}
+
+	/**
+	 * Account for an object allocated directly in tenure. Called by the mutator that
+	 * allocated it.
+	 */
+	MMINLINE void
+	addPretenuredBytes(uintptr_t bytes)
+	{
+		VM_AtomicSupport::add(&_pretenuredBytes, bytes);
+	}
+
+	/**
+	 * Get the bytes allocated directly in tenure since the last call, and start counting again.
+	 */
+	MMINLINE uintptr_t
+	resetPretenuredBytes()
+	{
+		return VM_AtomicSupport::set(&_pretenuredBytes, 0);
+	}
+
+	MMINLINE AllocationSites *
+	getAllocationSites()
+	{
+		return &_allocationSites;
+	}
+
+	MMINLINE void
+	setZeroingStrategy(Splash::ZeroingStrategy strategy)
+	{
+		_zeroingStrategy = strategy;
+	}
+
+	MMINLINE Splash::ZeroingStrategy
+	getZeroingStrategy()
+	{
+		return _zeroingStrategy;
+	}
+
+	MMINLINE TLHSizing *
+	getTLHSizing()
+	{
+		return &_tlhSizing;
+	}
+
+	MMINLINE ExternalArrays *
+	getExternalArrays()
+	{
+		return &_externalArrays;
+	}
+
 	/**
 	 * If the received object holds an indirect reference (ie a reference to an object
 	 * that is not reachable from the object reference graph) a pointer to the referenced
@@ -121,7 +242,7 @@ public:
 	MMINLINE uintptr_t
 	getObjectHeaderSizeInBytes(omrobjectptr_t objectPtr)
 	{
-		return 0; // SPLASH TODO
+		return sizeof(Splash::ArrayHeader);
 	}
 
 	/**
@@ -149,7 +270,7 @@ public:
 	MMINLINE uintptr_t
 	getObjectSizeInBytesWithHeader(omrobjectptr_t objectPtr)
 	{
-		return 0; // SPLASH TODO
+		return Splash::size(objectPtr);
 	}
 
 	/**
@@ -160,14 +281,16 @@ public:
 	 * Languages that support indexable objects (e.g. arrays) must provide an implementation
 	 * that distinguishes indexable and scalar objects and handles them appropriately.
 	 *
+	 * The leaves of a Splash::Spine are heap objects of their own, which are walked and
+	 * counted separately, so a spine's footprint is just the spine.
+	 *
 	 * @param[in] objectPtr points to the object to determine size for
 	 * @return the total size of an object, in bytes, including discontiguous parts
 	 */
 	MMINLINE uintptr_t
 	getTotalFootprintInBytes(omrobjectptr_t objectPtr)
 	{
-		Assert_MM_false(isIndexable(objectPtr));
-		return getObjectSizeInBytesWithHeader(objectPtr);
+		return Splash::size(objectPtr);
 	}
 
 	/**
@@ -192,7 +315,20 @@ public:
 	MMINLINE bool
 	isIndexable(omrobjectptr_t objectPtr)
 	{
-		return false;
+		switch (Splash::kind(objectPtr)) {
+		case Splash::Kind::REF:
+		case Splash::Kind::BIN:
+		case Splash::Kind::EXT:
+		case Splash::Kind::SPINE:
+		case Splash::Kind::I32:
+		case Splash::Kind::I64:
+		case Splash::Kind::F32:
+		case Splash::Kind::F64:
+		case Splash::Kind::VAL:
+			return true;
+		default:
+			return false;
+		}
 	}
 
 	/**
@@ -211,7 +347,7 @@ public:
 	MMINLINE bool
 	isIndexable(MM_ForwardedHeader *forwardedHeader)
 	{
-		return false;
+		return Splash::Kind::REC != getPreservedHeader(forwardedHeader).kind();
 	}
 
 	/**
@@ -224,8 +360,30 @@ public:
 	MMINLINE uintptr_t
 	getForwardedObjectSizeInBytes(MM_ForwardedHeader *forwardedHeader)
 	{
-		// SPLASH TODO!
-		return 0;
+		return Splash::size(getPreservedHeader(forwardedHeader));
+	}
+
+	/**
+	 * Recover the original header of an object that is being forwarded. Every Splash object can
+	 * be sized from its header alone, so no other part of the object needs to be read.
+	 *
+	 * With compressed pointers, the preserved slot only holds the low half of the 64 bit header,
+	 * and the high half is kept in the preserved overlap.
+	 *
+	 * @param[in] forwardedHeader pointer to the MM_ForwardedHeader instance encapsulating the object
+	 * @return the header of the object as it was before forwarding
+	 */
+	MMINLINE Splash::ArrayHeader
+	getPreservedHeader(MM_ForwardedHeader *forwardedHeader)
+	{
+		Splash::ArrayHeader header(Splash::Kind::BIN, 0);
+#if defined(OMR_GC_COMPRESSED_POINTERS)
+		header.value = (uint64_t)forwardedHeader->getPreservedSlot()
+			| ((uint64_t)forwardedHeader->getPreservedOverlap() << 32);
+#else /* OMR_GC_COMPRESSED_POINTERS */
+		header.value = (uint64_t)forwardedHeader->getPreservedSlot();
+#endif /* OMR_GC_COMPRESSED_POINTERS */
+		return header;
 	}
 
 	/**
@@ -260,7 +418,15 @@ public:
 	/**
 	 * Constructor receives a copy of OMR's object flags mask, normalized to low order byte.
 	 */
-	ObjectModelDelegate(fomrobject_t omrHeaderSlotFlagsMask) {}
+	ObjectModelDelegate(fomrobject_t omrHeaderSlotFlagsMask)
+		: _scanPrefetchDistance(0)
+		, _pretenureThreshold(UINTPTR_MAX)
+		, _pretenuredBytes(0)
+		, _allocationSites()
+		, _zeroingStrategy(Splash::ZeroingStrategy::OBJECT)
+		, _tlhSizing()
+		, _externalArrays()
+	{}
 };
 
 }  // namespace GC
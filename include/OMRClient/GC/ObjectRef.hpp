@@ -26,10 +26,14 @@
 #include <cstdint>
 #include <cstddef>
 
+namespace Splash {
+union AnyArray;
+} // namespace Splash
+
 namespace OMRClient {
 namespace GC {
 
-using ObjectRef = void*; // SPLASH TODO
+using ObjectRef = Splash::AnyArray*;
 
 using ObjectAddress = std::uintptr_t;
 
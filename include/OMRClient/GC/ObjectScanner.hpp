@@ -52,10 +52,7 @@ public:
 /// Simple alias used by OMR to scan objects.  Internally in OMR, the symbol OMRClient::GC::ObjectScanner is used.
 /// This header is provided by the client to "bind" that name to the correct implementation.
 /// In our case, it's the ArrayScanner.
-
-// SPLASH TODO: Implement the ArrayScanner, and set the alias below.
-
-using ObjectScanner = NopScanner;
+using ObjectScanner = Splash::ArrayScanner;
 
 }  // namespace GC
 }  // namespace OMR
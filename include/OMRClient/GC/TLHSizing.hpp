@@ -0,0 +1,93 @@
+/*******************************************************************************
+ *  Copyright (c) 2018, 2018 IBM and others
+ *
+ *  This program and the accompanying materials are made available under
+ *  the terms of the Eclipse Public License 2.0 which accompanies this
+ *  distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ *  or the Apache License, Version 2.0 which accompanies this distribution and
+ *  is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  This Source Code may also be made available under the following
+ *  Secondary Licenses when the conditions for such availability set
+ *  forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ *  General Public License, version 2 with the GNU Classpath
+ *  Exception [1] and GNU General Public License, version 2 with the
+ *  OpenJDK Assembly Exception [2].
+ *
+ *  [1] https://www.gnu.org/software/classpath/license.html
+ *  [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ *  SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(OMRCLIENT_GC_TLHSIZING_HPP_)
+#define OMRCLIENT_GC_TLHSIZING_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OMRClient {
+namespace GC {
+
+/// Adaptive per-thread TLH sizing.
+///
+/// Before each GC, every thread's refresh size is moved towards the size that would have
+/// served the bytes it allocated since the previous GC in TARGET_REFRESHES refreshes. Threads
+/// that allocate heavily get large TLHs and refresh less often, while idle threads shrink
+/// back towards the minimum and hold on to less of the heap. A thread whose refreshes failed
+/// since the last GC has its refresh size halved, since the heap could not supply TLHs of
+/// that size. Threads allocating at least a maximum-sized TLH per cycle also prefetch ahead
+/// of their allocation pointer.
+class TLHSizing {
+public:
+	/// The number of refreshes per GC cycle the policy aims for.
+	static constexpr std::uintptr_t TARGET_REFRESHES = 8;
+
+	/// The default prefetch distance, in bytes, for threads that allocate heavily.
+	static constexpr std::uintptr_t DEFAULT_PREFETCH_DISTANCE = 256;
+
+	TLHSizing() : enabled_(true), prefetchDistance_(DEFAULT_PREFETCH_DISTANCE) {}
+
+	/// Enable or disable the adaptive policy. When disabled, OMR's own refresh sizing is used.
+	void setEnabled(bool enabled) { enabled_ = enabled; }
+
+	bool isEnabled() const { return enabled_; }
+
+	/// Set the prefetch distance for threads that allocate heavily. 0 disables prefetching.
+	void setPrefetchDistance(std::uintptr_t distance) { prefetchDistance_ = distance; }
+
+	std::uintptr_t getPrefetchDistance() const { return prefetchDistance_; }
+
+	/// The refresh size for the next cycle, given the current refresh size, the bytes of TLH
+	/// handed out and the refresh failures since the last GC. After a failure, the size is
+	/// halved. Otherwise, the result moves halfway from the current size towards the target,
+	/// so one unusual cycle does not swing it far.
+	std::uintptr_t nextRefreshSize(std::uintptr_t current, std::uintptr_t bytes, std::uintptr_t failures,
+	                               std::uintptr_t minimum, std::uintptr_t maximum) const {
+		std::uintptr_t next = current / 2;
+		if (failures == 0) {
+			next += (bytes / TARGET_REFRESHES) / 2;
+		}
+		if (next < minimum) {
+			next = minimum;
+		}
+		if (next > maximum) {
+			next = maximum;
+		}
+		return next;
+	}
+
+	/// The prefetch distance for a thread that was handed bytes of TLH since the last GC.
+	std::uintptr_t nextPrefetchDistance(std::uintptr_t bytes, std::uintptr_t maximum) const {
+		return (bytes >= maximum) ? prefetchDistance_ : 0;
+	}
+
+private:
+	bool enabled_;
+	std::uintptr_t prefetchDistance_;
+};
+
+}  // namespace GC
+}  // namespace OMRClient
+
+#endif // OMRCLIENT_GC_TLHSIZING_HPP_
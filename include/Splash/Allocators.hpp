@@ -24,11 +24,147 @@
 #define SPLASH_ALLOCATORS_HPP_
 
 #include <Splash/Arrays.hpp>
-#include <OMR/GC/Allocator.hpp>
+#include <Splash/ThreadLocalHeap.hpp>
+
+#include <new>
 
 namespace Splash {
 
-// SPLASH TODO
+/// A function-like object for initializing BinArray allocations
+class InitBinArray {
+public:
+	/// Construct an initializer for a BinArray with nbytes of data
+	InitBinArray(std::size_t nbytes, Site site = NO_SITE) : nbytes_(nbytes), site_(site) {}
+
+	/// InitBinArray is callable like a function
+	void operator()(BinArray* target) {
+		// Use placement-new to initialize the target with the BinArray constructor.
+		new(target) BinArray(nbytes_, site_);
+	}
+
+private:
+	std::size_t nbytes_;
+	Site site_;
+};
+
+/// Allocate a BinArray. The data is not zeroed, since it is never scanned.
+/// site tags the allocation site, so that sites whose arrays survive can be pretenured.
+inline BinArray* allocateBinArray(OMR::GC::Context& cx, std::size_t nbytes, Site site = NO_SITE) {
+	return inlineAllocateNonZero<BinArray>(cx, binArraySize(nbytes), InitBinArray(nbytes, site), site);
+}
+
+/// A function-like object for initializing RefArray allocations
+class InitRefArray {
+public:
+	InitRefArray(std::size_t nrefs, Site site = NO_SITE) : nrefs_(nrefs), site_(site) {}
+
+	void operator()(RefArray* target) {
+		new (target) RefArray(nrefs_, site_);
+	}
+
+private:
+	std::size_t nrefs_;
+	Site site_;
+};
+
+/// Allocate a RefArray from zeroed memory, so every slot starts out null.
+/// site tags the allocation site, so that sites whose arrays survive can be pretenured.
+inline RefArray* allocateRefArray(OMR::GC::Context& cx, std::size_t nrefs, Site site = NO_SITE) {
+	return inlineAllocate<RefArray>(cx, refArraySize(nrefs), InitRefArray(nrefs, site), site);
+}
+
+/// A function-like object for initializing Record allocations
+class InitRecord {
+public:
+	InitRecord(std::size_t nwords, std::uint64_t refMap) : nwords_(nwords), refMap_(refMap) {}
+
+	void operator()(Record* target) {
+		new (target) Record(nwords_, refMap_);
+	}
+
+private:
+	std::size_t nwords_;
+	std::uint64_t refMap_;
+};
+
+/// Allocate a Record of nwords words. Bit i of refMap marks word i as a reference.
+/// The record is zeroed, so every reference starts out null. Returns nullptr if nwords
+/// is over RECORD_MAX_WORDS, or refMap marks a word past the end of the record.
+inline Record* allocateRecord(OMR::GC::Context& cx, std::size_t nwords, std::uint64_t refMap) {
+	if (nwords > RECORD_MAX_WORDS || (nwords < RECORD_MAX_WORDS && (refMap >> nwords) != 0)) {
+		return nullptr;
+	}
+	return inlineAllocate<Record>(cx, recordSize(nwords), InitRecord(nwords, refMap));
+}
+
+/// A function-like object for initializing ValueArray allocations
+class InitValueArray {
+public:
+	InitValueArray(std::size_t length, std::size_t stride, std::uint64_t refMap)
+		: length_(length), stride_(stride), refMap_(refMap) {}
+
+	void operator()(ValueArray* target) {
+		new (target) ValueArray(length_, stride_, refMap_);
+	}
+
+private:
+	std::size_t length_;
+	std::size_t stride_;
+	std::uint64_t refMap_;
+};
+
+/// Allocate an array of length inline elements, each stride words long. Bit i of
+/// refMap marks word i of every element as a reference. The array is zeroed, so
+/// every reference starts out null. Returns nullptr if stride is not between 1 and
+/// RECORD_MAX_WORDS, refMap marks a word past the end of an element, or length does not
+/// fit the 32 bit length of the array header.
+inline ValueArray* allocateValueArray(OMR::GC::Context& cx, std::size_t length,
+                                      std::size_t stride, std::uint64_t refMap) {
+	if (stride == 0 || stride > RECORD_MAX_WORDS || length > UINT32_MAX) {
+		return nullptr;
+	}
+	if (stride < RECORD_MAX_WORDS && (refMap >> stride) != 0) {
+		return nullptr;
+	}
+	return inlineAllocate<ValueArray>(
+		cx, valueArraySize(stride, length), InitValueArray(length, stride, refMap));
+}
+
+/// A function-like object for initializing typed primitive array allocations
+template <typename T>
+class InitPrimArray {
+public:
+	InitPrimArray(std::size_t n) : n_(n) {}
+
+	void operator()(PrimArray<T>* target) {
+		new (target) PrimArray<T>(n_);
+	}
+
+private:
+	std::size_t n_;
+};
+
+/// Allocate an array of n numbers of type T. Like a BinArray, the data is not zeroed.
+template <typename T>
+inline PrimArray<T>* allocatePrimArray(OMR::GC::Context& cx, std::size_t n) {
+	return inlineAllocateNonZero<PrimArray<T>>(cx, primArraySize<T>(n), InitPrimArray<T>(n));
+}
+
+inline I32Array* allocateI32Array(OMR::GC::Context& cx, std::size_t n) {
+	return allocatePrimArray<std::int32_t>(cx, n);
+}
+
+inline I64Array* allocateI64Array(OMR::GC::Context& cx, std::size_t n) {
+	return allocatePrimArray<std::int64_t>(cx, n);
+}
+
+inline F32Array* allocateF32Array(OMR::GC::Context& cx, std::size_t n) {
+	return allocatePrimArray<float>(cx, n);
+}
+
+inline F64Array* allocateF64Array(OMR::GC::Context& cx, std::size_t n) {
+	return allocatePrimArray<double>(cx, n);
+}
 
 } // namespace Splash
 
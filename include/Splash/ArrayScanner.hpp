@@ -25,12 +25,397 @@
 
 #include <Splash/Arrays.hpp>
 #include <OMR/GC/ScanResult.hpp>
-#include <stdexcept>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(SPLASH_SIMD_SCAN) && (defined(__AVX2__) || defined(__SSE2__))
+#include <immintrin.h>
+#endif
 
 namespace Splash {
 
-// SPLASH TODO
+/// Find the first non-null slot in [begin, end), or end if every slot is null.
+///
+/// When built with SPLASH_SIMD_SCAN, whole cache lines of slots are tested at once,
+/// using AVX2 if the compiler targets it, and SSE2 otherwise. Compressed and full
+/// width slots are both null when every byte is zero, so the vector test does not
+/// depend on the slot width. The scalar loop finds the exact slot.
+inline RefSlot* findNonNull(RefSlot* begin, RefSlot* end) {
+	RefSlot* current = begin;
+
+#if defined(SPLASH_SIMD_SCAN) && defined(__AVX2__)
+	constexpr std::ptrdiff_t STEP = 64 / sizeof(RefSlot);
+	while (end - current >= STEP) {
+		__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current));
+		__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current + (STEP / 2)));
+		__m256i any = _mm256_or_si256(a, b);
+		if (!_mm256_testz_si256(any, any)) {
+			break;
+		}
+		current += STEP;
+	}
+#elif defined(SPLASH_SIMD_SCAN) && defined(__SSE2__)
+	constexpr std::ptrdiff_t STEP = 64 / sizeof(RefSlot);
+	const __m128i zero = _mm_setzero_si128();
+	while (end - current >= STEP) {
+		const __m128i* p = reinterpret_cast<const __m128i*>(current);
+		__m128i any = _mm_or_si128(
+			_mm_or_si128(_mm_loadu_si128(p + 0), _mm_loadu_si128(p + 1)),
+			_mm_or_si128(_mm_loadu_si128(p + 2), _mm_loadu_si128(p + 3)));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(any, zero)) != 0xFFFF) {
+			break;
+		}
+		current += STEP;
+	}
+#endif
+
+	while (current != end && *current == RefSlot(0)) {
+		current += 1;
+	}
+	return current;
+}
+
+/// Prefetch the memory at address into the cache, if the compiler supports it.
+inline void prefetch(const void* address) {
+#if defined(__GNUC__)
+	__builtin_prefetch(address);
+#endif
+}
+
+/// True if VisitorT has a batch entry point, callable as:
+///
+///   bool edges(void* object, RefSlot* begin, RefSlot* end);
+///
+/// The scanner hands such visitors whole runs of RefArray and Spine slots, instead of
+/// calling edge() once per slot. A run may contain null slots. Returning false pauses
+/// the scan after the run.
+template <typename VisitorT, typename = void>
+struct HasBatchEdges : std::false_type {};
+
+template <typename VisitorT>
+struct HasBatchEdges<VisitorT, decltype(void(std::declval<VisitorT&>().edges(
+	std::declval<void*>(), std::declval<RefSlot*>(), std::declval<RefSlot*>())))>
+	: std::true_type {};
+
+class ArrayScanner {
+public:
+	ArrayScanner() = default;
+
+	/// A scanner that prefetches the referent of the slot prefetchDistance slots ahead
+	/// of the slot being visited. A distance of 0 disables prefetching.
+	explicit ArrayScanner(std::size_t prefetchDistance)
+		: prefetchDistance_(prefetchDistance) {}
+
+	ArrayScanner(const ArrayScanner&) = default;
+
+	template <typename VisitorT>
+	OMR::GC::ScanResult
+	start(VisitorT&& visitor, AnyArray* any, std::size_t bytesToScan = SIZE_MAX) {
+		target_ = any;
+		switch(kind(any)) {
+		case Kind::REF:
+			return startRefArray(std::forward<VisitorT>(visitor), bytesToScan);
+		case Kind::SPINE:
+			return startSpine(std::forward<VisitorT>(visitor), bytesToScan);
+		case Kind::REC:
+			return startRecord(std::forward<VisitorT>(visitor), bytesToScan);
+		case Kind::VAL:
+			return startValueArray(std::forward<VisitorT>(visitor), bytesToScan);
+		case Kind::BIN:
+		case Kind::EXT:
+		case Kind::I32:
+		case Kind::I64:
+		case Kind::F32:
+		case Kind::F64:
+			// no references to scan
+			return {0, true};
+		default:
+			// uh-oh: corrupt heap!
+			assert(0);
+			return {0, true};
+		}
+	}
+
+	template <typename VisitorT>
+	OMR::GC::ScanResult
+	resume(VisitorT&& visitor, std::size_t bytesToScan = SIZE_MAX) {
+		switch(kind(target_)) {
+		case Kind::REF:
+		case Kind::SPINE:
+			return resumeSlots(std::forward<VisitorT>(visitor), bytesToScan);
+		case Kind::REC:
+			return resumeRecord(std::forward<VisitorT>(visitor), bytesToScan);
+		case Kind::VAL:
+			return resumeValueArray(std::forward<VisitorT>(visitor), bytesToScan);
+		case Kind::BIN:
+		case Kind::EXT:
+		case Kind::I32:
+		case Kind::I64:
+		case Kind::F32:
+		case Kind::F64:
+			// uh-oh: should never resume a BinArray or typed array
+			assert(0);
+			return {0, true};
+		default:
+			// uh-oh: corrupt heap!
+			assert(0);
+			return {0, true};
+		}
+	}
+
+private:
+	template <typename VisitorT>
+	OMR::GC::ScanResult
+	startRefArray(VisitorT&& visitor, std::size_t bytesToScan) {
+		current_ = target_->asRefArray.begin();
+		end_ = target_->asRefArray.end();
+		return resumeSlots(std::forward<VisitorT>(visitor), bytesToScan);
+	}
+
+	/// A spine's only references are to it's leaves, which are scanned as objects of their own.
+	template <typename VisitorT>
+	OMR::GC::ScanResult
+	startSpine(VisitorT&& visitor, std::size_t bytesToScan) {
+		current_ = target_->asSpine.begin();
+		end_ = target_->asSpine.end();
+		return resumeSlots(std::forward<VisitorT>(visitor), bytesToScan);
+	}
+
+	/// The end of the slots that can be scanned with the remaining budget.
+	RefSlot* budgetLimit(std::size_t bytesScanned, std::size_t bytesToScan) const {
+		std::size_t remaining = bytesToScan - bytesScanned;
+		std::size_t budgetSlots = (remaining / sizeof(RefSlot)) + (remaining % sizeof(RefSlot) != 0);
+		return std::size_t(end_ - current_) <= budgetSlots ? end_ : current_ + budgetSlots;
+	}
+
+	template <typename VisitorT>
+	OMR::GC::ScanResult
+	resumeSlots(VisitorT&& visitor, std::size_t bytesToScan) {
+		using Batched = HasBatchEdges<typename std::remove_reference<VisitorT>::type>;
+		return resumeSlots(std::forward<VisitorT>(visitor), bytesToScan, Batched());
+	}
+
+	/// Hand the visitor runs of slots, as large as the budget allows. Leading null slots
+	/// are skipped before each run. With prefetching on, runs are at most prefetchDistance
+	/// slots long, and the referents of the next prefetchDistance slots are loaded while
+	/// the visitor works through a run.
+	template <typename VisitorT>
+	OMR::GC::ScanResult
+	resumeSlots(VisitorT&& visitor, std::size_t bytesToScan, std::true_type) {
+		RefSlot* end = end_;
+
+		assert(current_ <= end);
+
+		bool cont = true;
+		std::size_t bytesScanned = 0;
+
+		while (true) {
+			if (current_ == end) {
+				// object complete
+				return {bytesScanned, true};
+			}
+			if (bytesScanned >= bytesToScan || !cont) {
+				// hit scan budget or paused by visitor
+				return {bytesScanned, false};
+			}
+
+			RefSlot* limit = budgetLimit(bytesScanned, bytesToScan);
+			RefSlot* begin = findNonNull(current_, limit);
+			if (begin != limit) {
+				if (prefetchDistance_ != 0) {
+					if (std::size_t(limit - begin) > prefetchDistance_) {
+						limit = begin + prefetchDistance_;
+					}
+					RefSlot* ahead = std::size_t(end - limit) > prefetchDistance_ ? limit + prefetchDistance_ : end;
+					for (RefSlot* slot = limit; slot != ahead; ++slot) {
+						if (*slot != RefSlot(0)) {
+							prefetch(SlotHandle(slot).readReference());
+						}
+					}
+				}
+				cont = visitor.edges(target_, begin, limit);
+			}
+			bytesScanned += (limit - current_) * sizeof(RefSlot);
+			current_ = limit;
+		}
+
+		// unreachable
+	}
+
+	/// Visit each non-null slot with a call to edge().
+	template <typename VisitorT>
+	OMR::GC::ScanResult
+	resumeSlots(VisitorT&& visitor, std::size_t bytesToScan, std::false_type) {
+		RefSlot* end = end_;
+
+		assert(current_ <= end);
+
+		bool cont = true;
+		std::size_t bytesScanned = 0;
+
+		while (true) {
+			if (current_ == end) {
+				// object complete
+				return {bytesScanned, true};
+			}
+			if (bytesScanned >= bytesToScan || !cont) {
+				// hit scan budget or paused by visitor
+				return {bytesScanned, false};
+			}
+
+			// Skip the run of null slots ahead, but no further than the budget allows.
+			// Skipped slots count as scanned.
+			RefSlot* limit = budgetLimit(bytesScanned, bytesToScan);
+
+			RefSlot* next = findNonNull(current_, limit);
+			bytesScanned += (next - current_) * sizeof(RefSlot);
+			current_ = next;
+			if (current_ == limit) {
+				continue;
+			}
+
+			// Start loading the referent of a slot ahead, so it's header is in cache by
+			// the time it is visited.
+			if (prefetchDistance_ != 0 && std::size_t(end - current_) > prefetchDistance_) {
+				RefSlot* ahead = current_ + prefetchDistance_;
+				if (*ahead != RefSlot(0)) {
+					prefetch(SlotHandle(ahead).readReference());
+				}
+			}
+
+			cont = visitor.edge(target_, SlotHandle(current_));
+			current_ += 1;
+			bytesScanned += sizeof(RefSlot);
+		}
+
+		// unreachable
+	}
+
+	/// Visit only the words of a record that are marked in it's refMap. The unvisited
+	/// bits are kept in pending_, so a paused scan resumes at the next reference word.
+	template <typename VisitorT>
+	OMR::GC::ScanResult
+	startRecord(VisitorT&& visitor, std::size_t bytesToScan) {
+		pending_ = target_->asRecord.refMap;
+		return resumeRecord(std::forward<VisitorT>(visitor), bytesToScan);
+	}
+
+	template <typename VisitorT>
+	OMR::GC::ScanResult
+	resumeRecord(VisitorT&& visitor, std::size_t bytesToScan) {
+		Record& record = target_->asRecord;
+
+		bool cont = true;
+		std::size_t bytesScanned = 0;
+
+		while (true) {
+			if (pending_ == 0) {
+				// object complete
+				return {bytesScanned, true};
+			}
+			if (bytesScanned >= bytesToScan || !cont) {
+				// hit scan budget or paused by visitor
+				return {bytesScanned, false};
+			}
+
+			std::size_t index = lowestSetBit(pending_);
+			pending_ &= pending_ - 1;
+
+			RefSlot* slot = record.slot(index);
+			if (*slot != RefSlot(0)) {
+				cont = visitor.edge(target_, SlotHandle(slot));
+			}
+
+			bytesScanned += sizeof(std::uint64_t);
+		}
+
+		// unreachable
+	}
+
+	/// Visit the reference words of each element in turn. element_ is the element being
+	/// scanned, and pending_ holds it's unvisited reference bits, so a paused scan
+	/// resumes part way through an element.
+	template <typename VisitorT>
+	OMR::GC::ScanResult
+	startValueArray(VisitorT&& visitor, std::size_t bytesToScan) {
+		ValueArray& array = target_->asValueArray;
+		if (array.refMap == 0 || array.length() == 0) {
+			// no references to scan
+			return {0, true};
+		}
+		element_ = array.element(0);
+		elementsEnd_ = array.end();
+		pending_ = array.refMap;
+		return resumeValueArray(std::forward<VisitorT>(visitor), bytesToScan);
+	}
+
+	template <typename VisitorT>
+	OMR::GC::ScanResult
+	resumeValueArray(VisitorT&& visitor, std::size_t bytesToScan) {
+		ValueArray& array = target_->asValueArray;
+		const std::size_t stride = array.stride();
+		const std::uint64_t refMap = array.refMap;
+
+		assert(element_ <= elementsEnd_);
+
+		bool cont = true;
+		std::size_t bytesScanned = 0;
+
+		while (true) {
+			if (pending_ == 0) {
+				element_ += stride;
+				pending_ = refMap;
+			}
+			if (element_ == elementsEnd_) {
+				// object complete
+				return {bytesScanned, true};
+			}
+			if (bytesScanned >= bytesToScan || !cont) {
+				// hit scan budget or paused by visitor
+				return {bytesScanned, false};
+			}
+
+			std::size_t index = lowestSetBit(pending_);
+			pending_ &= pending_ - 1;
+
+			RefSlot* slot = reinterpret_cast<RefSlot*>(&element_[index]);
+			if (*slot != RefSlot(0)) {
+				cont = visitor.edge(target_, SlotHandle(slot));
+			}
+
+			bytesScanned += sizeof(std::uint64_t);
+		}
+
+		// unreachable
+	}
+
+	/// The index of the least significant set bit. bits must not be zero.
+	static std::size_t lowestSetBit(std::uint64_t bits) {
+		assert(bits != 0);
+#if defined(__GNUC__)
+		return __builtin_ctzll(bits);
+#else
+		std::size_t index = 0;
+		while ((bits & 1) == 0) {
+			bits >>= 1;
+			index += 1;
+		}
+		return index;
+#endif
+	}
+
+	AnyArray* target_;
+	RefSlot* current_;
+	RefSlot* end_;
+	std::uint64_t pending_;
+	std::uint64_t* element_;
+	std::uint64_t* elementsEnd_;
+	std::size_t prefetchDistance_ = 0;
+};
 
 }  // namespace Splash
 
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ *  Copyright (c) 2018, 2018 IBM and others
+ *
+ *  This program and the accompanying materials are made available under
+ *  the terms of the Eclipse Public License 2.0 which accompanies this
+ *  distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ *  or the Apache License, Version 2.0 which accompanies this distribution and
+ *  is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  This Source Code may also be made available under the following
+ *  Secondary Licenses when the conditions for such availability set
+ *  forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ *  General Public License, version 2 with the GNU Classpath
+ *  Exception [1] and GNU General Public License, version 2 with the
+ *  OpenJDK Assembly Exception [2].
+ *
+ *  [1] https://www.gnu.org/software/classpath/license.html
+ *  [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ *  SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(SPLASH_ARRAYLETS_HPP_)
+#define SPLASH_ARRAYLETS_HPP_
+
+#include <Splash/Allocators.hpp>
+#include <Splash/Arrays.hpp>
+#include <Splash/Barriers.hpp>
+#include <OMR/GC/StackRoot.hpp>
+
+namespace Splash {
+
+/// A function-like object for initializing Spine allocations
+class InitSpine {
+public:
+	InitSpine(Kind elementKind, std::size_t length)
+		: elementKind_(elementKind), length_(length) {}
+
+	void operator()(Spine* target) {
+		new (target) Spine(elementKind_, length_);
+	}
+
+private:
+	Kind elementKind_;
+	std::size_t length_;
+};
+
+/// Allocate a discontiguous array of length REF or BIN elements. The spine is allocated
+/// from zeroed memory, so the leaf slots are null until each leaf is allocated and
+/// stored. Returns nullptr if the spine or any leaf could not be allocated, or if length
+/// does not fit the 32 bit length of the spine header.
+inline Spine* allocateSpine(OMR::GC::Context& cx, Kind elementKind, std::size_t length) {
+	assert(elementKind == Kind::REF || elementKind == Kind::BIN);
+
+	if (length > UINT32_MAX) {
+		return nullptr;
+	}
+
+	OMR::GC::StackRoot<Spine> spine(cx);
+	spine = inlineAllocate<Spine>(cx, spineSize(elementKind, length), InitSpine(elementKind, length));
+	if (spine == nullptr) {
+		return nullptr;
+	}
+
+	std::uint32_t nleaves = spine->leafCount();
+	for (std::uint32_t i = 0; i < nleaves; ++i) {
+		std::size_t n = leafLength(elementKind, length, i);
+		AnyArray* leaf = elementKind == Kind::REF
+			? (AnyArray*)allocateRefArray(cx, n)
+			: (AnyArray*)allocateBinArray(cx, n);
+		if (leaf == nullptr) {
+			return nullptr;
+		}
+		// The spine may have moved during the leaf allocation. Always re-read the root.
+		regionStore(cx, spine.get(), leaf);
+		DefaultBarrier::store(cx, (AnyArray*)spine.get(), SlotHandle(&spine->leaves[i]), leaf);
+	}
+
+	return spine.get();
+}
+
+/// Allocate a discontiguous array of nrefs references.
+inline Spine* allocateRefArraylet(OMR::GC::Context& cx, std::size_t nrefs) {
+	return allocateSpine(cx, Kind::REF, nrefs);
+}
+
+/// Allocate a discontiguous array of nbytes bytes.
+inline Spine* allocateBinArraylet(OMR::GC::Context& cx, std::size_t nbytes) {
+	return allocateSpine(cx, Kind::BIN, nbytes);
+}
+
+/// Return the leaf holding element index.
+inline AnyArray* leafFor(Spine& spine, std::size_t index) {
+	assert(index < spine.length());
+	return SlotHandle(&spine.leaves[index / leafCapacity(spine.elementKind())]).readReference();
+}
+
+/// Return the position of element index in it's leaf.
+inline std::size_t leafIndex(Spine& spine, std::size_t index) {
+	return index % leafCapacity(spine.elementKind());
+}
+
+/// Return a reference to the byte at index, in a BIN spine.
+inline std::uint8_t& byteAt(Spine& spine, std::size_t index) {
+	assert(spine.elementKind() == Kind::BIN);
+	return leafFor(spine, index)->asBinArray.data[leafIndex(spine, index)];
+}
+
+/// Return a handle to the slot at index, in a REF spine.
+inline SlotHandle at(Spine& spine, std::size_t index) {
+	assert(spine.elementKind() == Kind::REF);
+	return at(leafFor(spine, index)->asRefArray, leafIndex(spine, index));
+}
+
+/// Store a ref to the slot at index, in a REF spine. The barrier is applied to the leaf
+/// that holds the slot, since the leaf is the object being modified.
+inline void store(OMR::GC::RunContext& cx, Spine& spine, std::size_t index, AnyArray* value) {
+	assert(spine.elementKind() == Kind::REF);
+	store(cx, leafFor(spine, index)->asRefArray, leafIndex(spine, index), value);
+}
+
+/// Load the ref at index, in a REF spine.
+inline AnyArray* load(Spine& spine, std::size_t index) {
+	return at(spine, index).readReference();
+}
+
+} // namespace Splash
+
+#endif // SPLASH_ARRAYLETS_HPP_
@@ -26,8 +26,12 @@
 #include <objectdescription.h>
 
 #include <OMR/GC/RefSlotHandle.hpp>
+#if defined(OMR_GC_COMPRESSED_POINTERS)
+#include <AtomicSupport.hpp>
+#endif // OMR_GC_COMPRESSED_POINTERS
 
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <stdexcept>
@@ -40,12 +44,525 @@ align(std::size_t size, std::size_t alignment) {
 	return (size + alignment - 1) & ~(alignment - 1);
 }
 
+/// Base-2 logarithm of a power of two.
+constexpr std::size_t
+ilog2(std::size_t value) {
+	return value <= 1 ? 0 : 1 + ilog2(value >> 1);
+}
+
 namespace Splash {
 
-/////////////////////////////////////////////////
-// SPLASH TODO:
-// PUT YOUR CODE HERE!
-/////////////////////////////////////////////////
+/// All objects are aligned to 16 bytes.
+constexpr const std::size_t ALIGNMENT = 16;
+
+enum class Kind : std::uint8_t {
+	REF, BIN, SPINE, I32, I64, F32, F64, REC, VAL, EXT
+};
+
+/// An allocation site tag. Arrays allocated with the same tag are assumed to share a
+/// lifetime, and the collector tracks how many of their bytes survive each scavenge.
+using Site = std::uint8_t;
+
+/// The tag of arrays whose allocation site is not tracked.
+constexpr const Site NO_SITE = 0;
+
+/// The number of distinct allocation site tags, including NO_SITE.
+constexpr const std::size_t SITE_COUNT = 256;
+
+/// Metadata about an Array. Must be the first field of any heap object.
+///
+/// Encoding:
+///
+/// Bytes           | Property | Size | Offset |
+/// ----------------|----------|------|--------|
+/// 0               | Metadata |   08 |     00 |
+///   1             | Kind     |   08 |     08 |
+///     2 3 4 5     | Length   |   32 |     16 |
+///             6   | Layout   |   08 |     48 |
+///               7 | Site     |   08 |     56 |
+///
+/// The layout byte holds kind-specific information needed to size the object.
+/// A Spine stores the kind of its elements there. A typed primitive array stores
+/// log2 of its element width. For a Record, the length is the number of words. A
+/// ValueArray stores the stride of its elements, in words. An ExternalBinArray keeps
+/// its length out of the header, since its payload may exceed 4 GiB.
+///
+/// The site byte holds the allocation site tag, or NO_SITE.
+///
+/// Every object can be sized from its header alone.
+///
+struct ArrayHeader {
+	ArrayHeader(Kind k, std::uint32_t s, std::uint8_t l = 0, Site site = NO_SITE)
+		: value((std::uint64_t(site) << 56) | (std::uint64_t(l) << 48) | (std::uint64_t(s) << 16) | (std::uint64_t(k) << 8))
+	{}
+
+	/// The number of elements in this Array. Elements may be bytes or references.
+	/// NOT the total size in bytes.
+	std::uint32_t length() const {
+		return std::uint32_t((value >> 16) & 0xFFFFFFFF);
+	}
+
+	/// The kind of Array this is: either a RefArray or BinArray
+	Kind kind() const {
+		return Kind((value >> 8) & 0xFF);
+	}
+
+	/// Kind-specific layout information.
+	std::uint8_t layout() const {
+		return std::uint8_t((value >> 48) & 0xFF);
+	}
+
+	/// The allocation site this Array was allocated at.
+	Site site() const {
+		return Site((value >> 56) & 0xFF);
+	}
+
+	std::uint64_t value;
+};
+
+struct BinArray {
+	BinArray(std::uint32_t nbytes, Site site = NO_SITE)
+		: header(Kind::BIN, nbytes, 0, site) {}
+
+	ArrayHeader header;
+	std::uint8_t data[];
+};
+
+constexpr std::size_t binArraySize(std::uint32_t nbytes) {
+	return align(sizeof(BinArray) + nbytes, ALIGNMENT);
+}
+
+/// Releases the payload of an ExternalBinArray, once the array is dead.
+using ReleaseFunction = void (*)(std::uint8_t* payload, std::uint64_t nbytes);
+
+/// A BinArray whose bytes live outside the heap, for example in a mapped file. Only this
+/// fixed-size object is allocated in the heap, and like a BinArray it is never scanned.
+/// After a collection finds the array dead, release is called on the payload.
+struct ExternalBinArray {
+	ExternalBinArray(std::uint8_t* payload, std::uint64_t nbytes, ReleaseFunction release, Site site = NO_SITE)
+		: header(Kind::EXT, 0, 0, site), nbytes(nbytes), payload(payload), release(release) {}
+
+	/// The number of bytes in the payload.
+	std::uint64_t length() const { return nbytes; }
+
+	ArrayHeader header;
+	std::uint64_t nbytes;
+	std::uint8_t* payload;
+	ReleaseFunction release;
+};
+
+constexpr std::size_t externalBinArraySize() {
+	return align(sizeof(ExternalBinArray), ALIGNMENT);
+}
+
+#if defined(OMR_GC_COMPRESSED_POINTERS)
+
+/// Compressed references are heap addresses shifted right by the number of
+/// always-zero low bits implied by the object alignment. With 16 byte alignment,
+/// a 32 bit reference can address the first 64 GiB of memory. The whole heap
+/// must be located beneath that address.
+constexpr const std::size_t COMPRESSED_REF_SHIFT = ilog2(ALIGNMENT);
+
+static_assert((std::size_t(1) << COMPRESSED_REF_SHIFT) == ALIGNMENT,
+	"ALIGNMENT must be a power of two");
+
+/// A 32 bit compressed reference.
+using CompressedRef = std::uint32_t;
+
+/// Encode a reference. The null reference is encoded as 0.
+inline CompressedRef compress(AnyArray* ref) {
+	std::uintptr_t address = reinterpret_cast<std::uintptr_t>(ref);
+	assert((address & (ALIGNMENT - 1)) == 0);
+	assert((address >> COMPRESSED_REF_SHIFT) <= UINT32_MAX);
+	return CompressedRef(address >> COMPRESSED_REF_SHIFT);
+}
+
+/// Decode a reference.
+inline AnyArray* decompress(CompressedRef ref) {
+	return reinterpret_cast<AnyArray*>(std::uintptr_t(ref) << COMPRESSED_REF_SHIFT);
+}
+
+/// A handle to a slot containing a compressed reference. Implements the
+/// SlotHandle concept, so it may be passed to visitors and to OMR::GC::store.
+class CompressedRefSlotHandle {
+public:
+	explicit CompressedRefSlotHandle(CompressedRef* slot) : slot_(slot) {}
+
+	void* toAddress() const noexcept { return slot_; }
+
+	AnyArray* readReference() const noexcept { return decompress(*slot_); }
+
+	void writeReference(AnyArray* value) const noexcept { *slot_ = compress(value); }
+
+	void atomicWriteReference(AnyArray* value) const noexcept {
+		CompressedRef newValue = compress(value);
+		CompressedRef oldValue;
+		do {
+			oldValue = *slot_;
+		} while (oldValue != VM_AtomicSupport::lockCompareExchangeU32(slot_, oldValue, newValue));
+	}
+
+private:
+	CompressedRef* slot_;
+};
+
+using RefSlot = CompressedRef;
+
+/// The handle type for slots in a RefArray.
+using SlotHandle = CompressedRefSlotHandle;
+
+#else // OMR_GC_COMPRESSED_POINTERS
+
+using RefSlot = AnyArray*;
+
+/// The handle type for slots in a RefArray.
+using SlotHandle = OMR::GC::RefSlotHandle;
+
+#endif // OMR_GC_COMPRESSED_POINTERS
+
+struct RefArray {
+	RefArray(std::uint32_t nrefs, Site site = NO_SITE)
+		: header(Kind::REF, nrefs, 0, site) {}
+
+	std::uint32_t length() const { return header.length(); }
+
+	/// Returns a pointer to the first slot.
+	RefSlot* begin() { return &data[0]; }
+
+	/// Returns a pointer "one-past-the-end" of the slots.
+	RefSlot* end() { return &data[length()]; }
+
+	ArrayHeader header;
+	RefSlot data[];
+};
+
+constexpr std::size_t refArraySize(std::uint32_t nrefs) {
+	return align(sizeof(RefArray) + (sizeof(RefSlot) * nrefs), ALIGNMENT);
+}
+
+/// Maps a primitive element type to it's array Kind.
+template <typename T>
+struct KindOf;
+
+template <> struct KindOf<std::int32_t> { static constexpr Kind value = Kind::I32; };
+template <> struct KindOf<std::int64_t> { static constexpr Kind value = Kind::I64; };
+template <> struct KindOf<float>        { static constexpr Kind value = Kind::F32; };
+template <> struct KindOf<double>       { static constexpr Kind value = Kind::F64; };
+
+/// The offset of the data in a typed primitive array. The header is padded out to
+/// the object alignment, so the payload of every typed array is 16 byte aligned, and
+/// may be loaded directly into SSE/NEON registers.
+constexpr const std::size_t PRIM_DATA_OFFSET = ALIGNMENT;
+
+/// An array of unboxed numbers. Like a BinArray, a PrimArray is never scanned.
+template <typename T>
+struct PrimArray {
+	PrimArray(std::uint32_t n)
+		: header(KindOf<T>::value, n, std::uint8_t(ilog2(sizeof(T)))) {}
+
+	std::uint32_t length() const { return header.length(); }
+
+	T* begin() { return &data[0]; }
+
+	T* end() { return &data[length()]; }
+
+	const T* begin() const { return &data[0]; }
+
+	const T* end() const { return &data[length()]; }
+
+	ArrayHeader header;
+	std::uint8_t padding[PRIM_DATA_OFFSET - sizeof(ArrayHeader)];
+	T data[];
+};
+
+using I32Array = PrimArray<std::int32_t>;
+using I64Array = PrimArray<std::int64_t>;
+using F32Array = PrimArray<float>;
+using F64Array = PrimArray<double>;
+
+/// Size of a typed primitive array, from log2 of the element width.
+constexpr std::size_t primArraySize(std::uint8_t widthShift, std::uint32_t n) {
+	return align(PRIM_DATA_OFFSET + (std::size_t(n) << widthShift), ALIGNMENT);
+}
+
+template <typename T>
+constexpr std::size_t primArraySize(std::uint32_t n) {
+	return primArraySize(std::uint8_t(ilog2(sizeof(T))), n);
+}
+
+/// True for the kinds of typed primitive arrays.
+constexpr bool isPrimKind(Kind k) {
+	return k == Kind::I32 || k == Kind::I64 || k == Kind::F32 || k == Kind::F64;
+}
+
+/// The number of data bytes held by each leaf of a discontiguous array.
+constexpr const std::size_t LEAF_SIZE = 64 * 1024;
+
+/// The size of one element of a RefArray or BinArray.
+constexpr std::size_t elementSize(Kind elementKind) {
+	return elementKind == Kind::REF ? sizeof(RefSlot) : 1;
+}
+
+/// The number of elements that fit in one leaf.
+constexpr std::size_t leafCapacity(Kind elementKind) {
+	return LEAF_SIZE / elementSize(elementKind);
+}
+
+/// The number of leaves needed to hold length elements.
+constexpr std::uint32_t leafCount(Kind elementKind, std::uint32_t length) {
+	return std::uint32_t((length + leafCapacity(elementKind) - 1) / leafCapacity(elementKind));
+}
+
+/// The number of elements held by leaf i. Every leaf is full, except possibly the last.
+constexpr std::uint32_t leafLength(Kind elementKind, std::uint32_t length, std::uint32_t i) {
+	return std::uint32_t(
+		(length - (i * leafCapacity(elementKind))) < leafCapacity(elementKind)
+			? length - (i * leafCapacity(elementKind))
+			: leafCapacity(elementKind));
+}
+
+/// The root of a discontiguous (arraylet) array. The elements live in a sequence of
+/// leaves, each an ordinary RefArray or BinArray of at most LEAF_SIZE bytes of data.
+/// The spine references its leaves, so the collector manages and moves each leaf
+/// independently, and a huge array never needs a contiguous block of heap.
+struct Spine {
+	Spine(Kind elementKind, std::uint32_t length)
+		: header(Kind::SPINE, length, std::uint8_t(elementKind)) {}
+
+	/// The number of elements in the whole array.
+	std::uint32_t length() const { return header.length(); }
+
+	/// The kind of the leaves: either REF or BIN.
+	Kind elementKind() const { return Kind(header.layout()); }
+
+	std::uint32_t leafCount() const { return Splash::leafCount(elementKind(), length()); }
+
+	/// Returns a pointer to the first leaf slot.
+	RefSlot* begin() { return &leaves[0]; }
+
+	/// Returns a pointer "one-past-the-end" of the leaf slots.
+	RefSlot* end() { return &leaves[leafCount()]; }
+
+	ArrayHeader header;
+	RefSlot leaves[];
+};
+
+constexpr std::size_t spineSize(Kind elementKind, std::uint32_t length) {
+	return align(sizeof(Spine) + (sizeof(RefSlot) * leafCount(elementKind, length)), ALIGNMENT);
+}
+
+/// The maximum number of words in a Record: one bit of the refMap per word.
+constexpr const std::size_t RECORD_MAX_WORDS = 64;
+
+/// A fixed-size object of 8 byte words. Some words hold references, the rest hold
+/// plain data. Bit i of the refMap is set when word i is a reference. A reference
+/// word holds a single RefSlot in its low address; with compressed references, the
+/// remaining bytes of the word are unused.
+struct Record {
+	Record(std::uint32_t nwords, std::uint64_t refMap)
+		: header(Kind::REC, nwords), refMap(refMap) {
+		assert(nwords <= RECORD_MAX_WORDS);
+		assert(nwords == RECORD_MAX_WORDS || (refMap >> nwords) == 0);
+	}
+
+	/// The number of words in this record.
+	std::uint32_t length() const { return header.length(); }
+
+	/// True if word i holds a reference.
+	bool isRef(std::size_t i) const { return (refMap >> i) & 1; }
+
+	/// The reference slot stored in word i. Word i must be a reference word.
+	RefSlot* slot(std::size_t i) {
+		assert(isRef(i));
+		return reinterpret_cast<RefSlot*>(&words[i]);
+	}
+
+	ArrayHeader header;
+	std::uint64_t refMap;
+	std::uint64_t words[];
+};
+
+constexpr std::size_t recordSize(std::uint32_t nwords) {
+	return align(sizeof(Record) + (sizeof(std::uint64_t) * nwords), ALIGNMENT);
+}
+
+/// An array of fixed-stride inline structs. Each element is stride words long, and
+/// every element shares the same refMap: bit i is set when word i of an element is a
+/// reference. Elements are laid out back to back, so walking the array is a linear
+/// sweep with no pointer chasing.
+struct ValueArray {
+	ValueArray(std::uint32_t length, std::uint8_t stride, std::uint64_t refMap)
+		: header(Kind::VAL, length, stride), refMap(refMap) {
+		assert(0 < stride && stride <= RECORD_MAX_WORDS);
+		assert(stride == RECORD_MAX_WORDS || (refMap >> stride) == 0);
+	}
+
+	/// The number of elements in this array.
+	std::uint32_t length() const { return header.length(); }
+
+	/// The number of words in each element.
+	std::size_t stride() const { return header.layout(); }
+
+	/// True if word i of each element holds a reference.
+	bool isRef(std::size_t i) const { return (refMap >> i) & 1; }
+
+	/// Returns a pointer to the first word of element index.
+	std::uint64_t* element(std::size_t index) { return &words[index * stride()]; }
+
+	/// Returns a pointer "one-past-the-end" of the last element.
+	std::uint64_t* end() { return &words[length() * stride()]; }
+
+	/// The reference slot stored in word field of element index.
+	RefSlot* slot(std::size_t index, std::size_t field) {
+		assert(isRef(field));
+		return reinterpret_cast<RefSlot*>(&element(index)[field]);
+	}
+
+	ArrayHeader header;
+	std::uint64_t refMap;
+	std::uint64_t words[];
+};
+
+constexpr std::size_t valueArraySize(std::uint8_t stride, std::uint32_t length) {
+	return align(sizeof(ValueArray) + (sizeof(std::uint64_t) * stride * std::size_t(length)), ALIGNMENT);
+}
+
+union AnyArray {
+	// AnyArray can not be constructed
+	AnyArray() = delete;
+
+	ArrayHeader asHeader;
+	RefArray asRefArray;
+	BinArray asBinArray;
+	ExternalBinArray asExternalBinArray;
+	Spine asSpine;
+	I32Array asI32Array;
+	I64Array asI64Array;
+	F32Array asF32Array;
+	F64Array asF64Array;
+	Record asRecord;
+	ValueArray asValueArray;
+};
+
+static_assert(offsetof(I32Array, data) % ALIGNMENT == 0, "typed payloads must be aligned");
+static_assert(offsetof(F64Array, data) % ALIGNMENT == 0, "typed payloads must be aligned");
+
+/// Find the kind of array by reading from it's header.
+inline Kind kind(AnyArray* any) {
+	return any->asHeader.kind();
+}
+
+/// Get the total allocation size of an object, from it's header. The collector uses
+/// this when the object itself is no longer readable, eg. while it is being forwarded.
+inline std::size_t size(ArrayHeader header) {
+	std::size_t sz = 0;
+	switch(header.kind()) {
+	case Kind::REF:
+		sz = refArraySize(header.length());
+		break;
+	case Kind::BIN:
+		sz = binArraySize(header.length());
+		break;
+	case Kind::SPINE:
+		sz = spineSize(Kind(header.layout()), header.length());
+		break;
+	case Kind::I32:
+	case Kind::I64:
+	case Kind::F32:
+	case Kind::F64:
+		sz = primArraySize(header.layout(), header.length());
+		break;
+	case Kind::REC:
+		sz = recordSize(header.length());
+		break;
+	case Kind::VAL:
+		sz = valueArraySize(header.layout(), header.length());
+		break;
+	case Kind::EXT:
+		sz = externalBinArraySize();
+		break;
+	default:
+		// unrecognized data!
+		assert(0);
+		break;
+	}
+	return sz;
+}
+
+/// Get the total allocation size of an array, in bytes.
+inline std::size_t size(AnyArray* any) {
+	return size(any->asHeader);
+}
+
+/// A view of the bytes of a BinArray or ExternalBinArray.
+struct ByteSpan {
+	std::uint8_t* begin() const { return data; }
+
+	std::uint8_t* end() const { return data + size; }
+
+	std::uint8_t* data;
+	std::size_t size;
+};
+
+/// The bytes of a BinArray or ExternalBinArray, wherever they live. The span of a BinArray
+/// points into the heap, so it is only valid until the array is moved.
+inline ByteSpan data(AnyArray* any) {
+	if (kind(any) == Kind::EXT) {
+		ExternalBinArray& array = any->asExternalBinArray;
+		return {array.payload, std::size_t(array.nbytes)};
+	}
+	assert(kind(any) == Kind::BIN);
+	return {any->asBinArray.data, any->asHeader.length()};
+}
+
+/// The reference slots of an object, for collectors that walk slots directly instead
+/// of through an ArrayScanner. Slots in [begin, end) may hold references, and isRef
+/// tells which ones do. In a RefArray or Spine, every slot is a reference. In a Record
+/// or ValueArray, the refMap repeats every stride words.
+struct SlotLayout {
+	/// The number of slots in one 8 byte word of a Record or ValueArray.
+	static constexpr std::size_t SLOTS_PER_WORD = sizeof(std::uint64_t) / sizeof(RefSlot);
+
+	/// True if slot index, counting from begin, holds a reference.
+	bool isRef(std::size_t index) const {
+		if (stride == 0) {
+			return true;
+		}
+		return (index % SLOTS_PER_WORD) == 0
+			&& ((refMap >> ((index / SLOTS_PER_WORD) % stride)) & 1);
+	}
+
+	RefSlot* begin;
+	RefSlot* end;
+	std::uint64_t refMap;
+	/// Words per repeat of the refMap, or 0 if every slot is a reference.
+	std::size_t stride;
+};
+
+/// Find the reference slots of an object. Objects without references get an empty layout.
+inline SlotLayout slotLayout(AnyArray* any) {
+	switch(kind(any)) {
+	case Kind::REF:
+		return {any->asRefArray.begin(), any->asRefArray.end(), 0, 0};
+	case Kind::SPINE:
+		return {any->asSpine.begin(), any->asSpine.end(), 0, 0};
+	case Kind::REC: {
+		Record& record = any->asRecord;
+		RefSlot* begin = reinterpret_cast<RefSlot*>(&record.words[0]);
+		RefSlot* end = reinterpret_cast<RefSlot*>(&record.words[record.length()]);
+		return {begin, record.refMap == 0 ? begin : end, record.refMap, record.length()};
+	}
+	case Kind::VAL: {
+		ValueArray& array = any->asValueArray;
+		RefSlot* begin = reinterpret_cast<RefSlot*>(array.element(0));
+		RefSlot* end = reinterpret_cast<RefSlot*>(array.end());
+		return {begin, array.refMap == 0 ? begin : end, array.refMap, array.stride()};
+	}
+	default:
+		// no references
+		return {nullptr, nullptr, 0, 0};
+	}
+}
 
 } // namespace Splash
 
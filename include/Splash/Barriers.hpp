@@ -23,15 +23,549 @@
 #if !defined(SPLASH_BARRIERS_HPP_)
 #define SPLASH_BARRIERS_HPP_
 
+#include <Splash/Allocators.hpp>
 #include <Splash/Arrays.hpp>
+#include <Splash/Region.hpp>
 #include <OMR/GC/System.hpp>
 #include <OMR/GC/AccessBarrier.hpp>
 #include <OMR/GC/RefSlotHandle.hpp>
 
+#include "omrcfg.h"
+#include "AtomicSupport.hpp"
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
 namespace Splash {
 
-// SPLASH TODO
+/// The rare path of every barrier policy: hand the store to the generic OMR barrier, which
+/// writes the slot and does whatever remembering or card marking the collector needs. Kept
+/// out of line, so the filters of the fast path stay small enough to inline.
+template <typename SlotHandleT>
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif // __GNUC__
+void storeSlow(OMR::GC::RunContext& cx, AnyArray* object, SlotHandleT slot, AnyArray* value) {
+	OMR::GC::store(cx, object, slot, value);
+}
+
+/// Run the rare path of the barrier for value, already written to a slot of object by an
+/// atomic update. The OMR barriers remember object, or dirty the card of object, so the
+/// store goes to a scratch slot: writing the real slot again could undo an update another
+/// thread made since. The scratch slot starts out null, so a barrier that reads the value
+/// being overwritten sees an empty slot rather than garbage.
+inline void postStoreSlow(OMR::GC::RunContext& cx, AnyArray* object, AnyArray* value) {
+	RefSlot scratch;
+	SlotHandle handle(&scratch);
+	handle.writeReference(nullptr);
+	storeSlow(cx, object, handle, value);
+}
+
+/// True if the scavenger is built in, and enabled for this run.
+inline bool scavengerEnabled(OMR::GC::RunContext& cx) {
+#if defined(OMR_GC_MODRON_SCAVENGER)
+	return cx.env()->getExtensions()->scavengerEnabled;
+#else // OMR_GC_MODRON_SCAVENGER
+	return false;
+#endif // OMR_GC_MODRON_SCAVENGER
+}
+
+/// True if concurrent mark is built in, and enabled for this run.
+inline bool concurrentMarkEnabled(OMR::GC::RunContext& cx) {
+#if defined(OMR_GC_MODRON_CONCURRENT_MARK)
+	return cx.env()->getExtensions()->concurrentMark;
+#else // OMR_GC_MODRON_CONCURRENT_MARK
+	return false;
+#endif // OMR_GC_MODRON_CONCURRENT_MARK
+}
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+
+/// True if object is in tenure.
+inline bool isOld(OMR::GC::RunContext& cx, AnyArray* object) {
+	return cx.env()->getExtensions()->isOld((omrobjectptr_t)object);
+}
+
+#endif // OMR_GC_MODRON_SCAVENGER
+
+/// True if object is in new space. Always false when the scavenger is not running, since
+/// the whole heap is then collected as one.
+inline bool isYoung(OMR::GC::RunContext& cx, AnyArray* object) {
+#if defined(OMR_GC_MODRON_SCAVENGER)
+	return scavengerEnabled(cx) && !isOld(cx, object);
+#else // OMR_GC_MODRON_SCAVENGER
+	return false;
+#endif // OMR_GC_MODRON_SCAVENGER
+}
+
+/// The barrier for the flat, mark-sweep collector, which needs none: every store is a
+/// plain write.
+struct FlatBarrier {
+	template <typename SlotHandleT>
+	static void store(OMR::GC::RunContext& cx, AnyArray* object, SlotHandleT slot, AnyArray* value) {
+		slot.writeReference(value);
+	}
+
+	/// An initializing store into a just-allocated object.
+	template <typename SlotHandleT>
+	static void initStore(OMR::GC::RunContext& cx, AnyArray* object, SlotHandleT slot, AnyArray* value, bool young) {
+		slot.writeReference(value);
+	}
+
+	/// Called once after the slots in [begin, end) of object were written directly.
+	static void postBatch(OMR::GC::RunContext& cx, AnyArray* object, RefSlot* begin, RefSlot* end) {}
+
+	/// Called after value was written to a slot of object by an atomic update.
+	static void postStore(OMR::GC::RunContext& cx, AnyArray* object, AnyArray* value) {}
+};
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+
+/// The generational barrier. The scavenger only needs to hear about young objects stored
+/// into old ones, so null values, young targets and old values are filtered inline.
+struct GenconBarrier {
+	template <typename SlotHandleT>
+	static void store(OMR::GC::RunContext& cx, AnyArray* object, SlotHandleT slot, AnyArray* value) {
+		if (value == nullptr || !isOld(cx, object) || isOld(cx, value)) {
+			slot.writeReference(value);
+			return;
+		}
+		storeSlow(cx, object, slot, value);
+	}
+
+	/// An initializing store into a just-allocated object. Nothing in a young object needs
+	/// remembering. A pretenured or large object may have been allocated old, and keeps the
+	/// barrier.
+	template <typename SlotHandleT>
+	static void initStore(OMR::GC::RunContext& cx, AnyArray* object, SlotHandleT slot, AnyArray* value, bool young) {
+		if (young) {
+			slot.writeReference(value);
+			return;
+		}
+		store(cx, object, slot, value);
+	}
+
+	/// Called once after the slots in [begin, end) of object were written directly. An old
+	/// object is remembered once, through the first young reference written, if any.
+	static void postBatch(OMR::GC::RunContext& cx, AnyArray* object, RefSlot* begin, RefSlot* end) {
+		if (!isOld(cx, object)) {
+			return;
+		}
+		for (RefSlot* slot = begin; slot != end; ++slot) {
+			AnyArray* value = SlotHandle(slot).readReference();
+			if (value != nullptr && !isOld(cx, value)) {
+				storeSlow(cx, object, SlotHandle(slot), value);
+				return;
+			}
+		}
+	}
+
+	/// Called after value was written to a slot of object by an atomic update.
+	static void postStore(OMR::GC::RunContext& cx, AnyArray* object, AnyArray* value) {
+		if (value != nullptr && isOld(cx, object) && !isOld(cx, value)) {
+			postStoreSlow(cx, object, value);
+		}
+	}
+};
+
+#endif // OMR_GC_MODRON_SCAVENGER
+
+/// The concurrent-mark barrier. Concurrent marking must hear about every new reference
+/// stored into a heap object, so only null values, and when the scavenger is running,
+/// young targets, which concurrent marking does not trace, are filtered inline.
+struct ConcurrentBarrier {
+	template <typename SlotHandleT>
+	static void store(OMR::GC::RunContext& cx, AnyArray* object, SlotHandleT slot, AnyArray* value) {
+		if (value == nullptr || isYoung(cx, object)) {
+			slot.writeReference(value);
+			return;
+		}
+		storeSlow(cx, object, slot, value);
+	}
+
+	/// An initializing store into a just-allocated object. Concurrent marking does not trace
+	/// young objects. Without the scavenger, every object is traced, and keeps the barrier.
+	template <typename SlotHandleT>
+	static void initStore(OMR::GC::RunContext& cx, AnyArray* object, SlotHandleT slot, AnyArray* value, bool young) {
+		if (young) {
+			slot.writeReference(value);
+			return;
+		}
+		store(cx, object, slot, value);
+	}
+
+	/// Called once after the slots in [begin, end) of object were written directly. The
+	/// barrier for the first non-null reference written covers the whole object for
+	/// concurrent marking: it dirties the card of the object, and the whole object is
+	/// rescanned when the card is cleaned. With the scavenger, the object is only remembered
+	/// for a young value, so if the first value is old, the rest are searched for a young one.
+	static void postBatch(OMR::GC::RunContext& cx, AnyArray* object, RefSlot* begin, RefSlot* end) {
+		if (isYoung(cx, object)) {
+			return;
+		}
+		for (RefSlot* slot = begin; slot != end; ++slot) {
+			AnyArray* value = SlotHandle(slot).readReference();
+			if (value != nullptr) {
+				storeSlow(cx, object, SlotHandle(slot), value);
+#if defined(OMR_GC_MODRON_SCAVENGER)
+				if (scavengerEnabled(cx) && isOld(cx, value)) {
+					GenconBarrier::postBatch(cx, object, slot + 1, end);
+				}
+#endif // OMR_GC_MODRON_SCAVENGER
+				return;
+			}
+		}
+	}
+
+	/// Called after value was written to a slot of object by an atomic update. The barrier
+	/// only needs the new value: the overwritten one was either marked already, or is still
+	/// reachable from elsewhere, or is garbage.
+	static void postStore(OMR::GC::RunContext& cx, AnyArray* object, AnyArray* value) {
+		if (value != nullptr && !isYoung(cx, object)) {
+			postStoreSlow(cx, object, value);
+		}
+	}
+};
+
+/// The barrier for the collectors built in and enabled for this run: the concurrent-mark
+/// barrier while concurrent mark is on, otherwise the generational barrier while the
+/// scavenger is on, otherwise none. Collectors that are not built in cost nothing.
+struct DefaultBarrier {
+	template <typename SlotHandleT>
+	static void store(OMR::GC::RunContext& cx, AnyArray* object, SlotHandleT slot, AnyArray* value) {
+		if (concurrentMarkEnabled(cx)) {
+			ConcurrentBarrier::store(cx, object, slot, value);
+#if defined(OMR_GC_MODRON_SCAVENGER)
+		} else if (scavengerEnabled(cx)) {
+			GenconBarrier::store(cx, object, slot, value);
+#endif // OMR_GC_MODRON_SCAVENGER
+		} else {
+			FlatBarrier::store(cx, object, slot, value);
+		}
+	}
+
+	template <typename SlotHandleT>
+	static void initStore(OMR::GC::RunContext& cx, AnyArray* object, SlotHandleT slot, AnyArray* value, bool young) {
+		if (concurrentMarkEnabled(cx)) {
+			ConcurrentBarrier::initStore(cx, object, slot, value, young);
+#if defined(OMR_GC_MODRON_SCAVENGER)
+		} else if (scavengerEnabled(cx)) {
+			GenconBarrier::initStore(cx, object, slot, value, young);
+#endif // OMR_GC_MODRON_SCAVENGER
+		} else {
+			FlatBarrier::initStore(cx, object, slot, value, young);
+		}
+	}
+
+	static void postBatch(OMR::GC::RunContext& cx, AnyArray* object, RefSlot* begin, RefSlot* end) {
+		if (concurrentMarkEnabled(cx)) {
+			ConcurrentBarrier::postBatch(cx, object, begin, end);
+#if defined(OMR_GC_MODRON_SCAVENGER)
+		} else if (scavengerEnabled(cx)) {
+			GenconBarrier::postBatch(cx, object, begin, end);
+#endif // OMR_GC_MODRON_SCAVENGER
+		}
+	}
+
+	static void postStore(OMR::GC::RunContext& cx, AnyArray* object, AnyArray* value) {
+		if (concurrentMarkEnabled(cx)) {
+			ConcurrentBarrier::postStore(cx, object, value);
+#if defined(OMR_GC_MODRON_SCAVENGER)
+		} else if (scavengerEnabled(cx)) {
+			GenconBarrier::postStore(cx, object, value);
+#endif // OMR_GC_MODRON_SCAVENGER
+		}
+	}
+};
+
+/// True if Barrier does everything the collectors of this build need. FlatBarrier does
+/// nothing, so it is only usable in a build with neither the scavenger nor concurrent mark.
+template <typename Barrier>
+constexpr bool isUsableBarrier() {
+#if defined(OMR_GC_MODRON_SCAVENGER) || defined(OMR_GC_MODRON_CONCURRENT_MARK)
+	return !std::is_same<Barrier, FlatBarrier>::value;
+#else // OMR_GC_MODRON_SCAVENGER || OMR_GC_MODRON_CONCURRENT_MARK
+	return true;
+#endif // OMR_GC_MODRON_SCAVENGER || OMR_GC_MODRON_CONCURRENT_MARK
+}
+
+template <typename T>
+class Fresh;
+
+/// Allocate a RefArray, like allocateRefArray, for initializing with initStore.
+inline Fresh<RefArray> allocateRefArrayFresh(OMR::GC::RunContext& cx, std::size_t nrefs, Site site = NO_SITE);
+
+/// Allocate a Record, like allocateRecord, for initializing with initStore. The handle
+/// holds nullptr if allocateRecord would return it.
+inline Fresh<Record> allocateRecordFresh(OMR::GC::RunContext& cx, std::size_t nwords, std::uint64_t refMap);
+
+/// Allocate a ValueArray, like allocateValueArray, for initializing with initStore. The
+/// handle holds nullptr if allocateValueArray would return it.
+inline Fresh<ValueArray> allocateValueArrayFresh(OMR::GC::RunContext& cx, std::size_t length,
+                                                 std::size_t stride, std::uint64_t refMap);
+
+/// An object the calling thread has just allocated, whose reference slots may be initialized
+/// with initStore. Only the allocate*Fresh allocators make one. It must not be kept across a
+/// collection point, such as another allocation: the object may be tenured, or moved.
+/// Whether the object was allocated young is found once, here, rather than on every store.
+template <typename T>
+class Fresh {
+public:
+	T* get() const { return object_; }
+
+	T* operator->() const { return object_; }
+
+	T& operator*() const { return *object_; }
+
+	/// True if the object was allocated in new space.
+	bool young() const { return young_; }
+
+	/// Debug builds check that no collection happened since the object was allocated, and
+	/// that an object allocated young is still in new space.
+	void check(OMR::GC::RunContext& cx) const {
+		assert(gcCount_ == cx.env()->getGCEnvironment()->gcCount);
+#if defined(OMR_GC_MODRON_SCAVENGER)
+		assert(!young_ || !isOld(cx, (AnyArray*)object_));
+#endif // OMR_GC_MODRON_SCAVENGER
+	}
+
+private:
+	friend Fresh<RefArray> allocateRefArrayFresh(OMR::GC::RunContext&, std::size_t, Site);
+	friend Fresh<Record> allocateRecordFresh(OMR::GC::RunContext&, std::size_t, std::uint64_t);
+	friend Fresh<ValueArray> allocateValueArrayFresh(OMR::GC::RunContext&, std::size_t,
+	                                                 std::size_t, std::uint64_t);
+
+	Fresh(OMR::GC::RunContext& cx, T* object)
+		: object_(object)
+		, young_(isYoung(cx, (AnyArray*)object))
+#if !defined(NDEBUG)
+		, gcCount_(cx.env()->getGCEnvironment()->gcCount)
+#endif // !NDEBUG
+	{}
+
+	T* object_;
+	bool young_;
+#if !defined(NDEBUG)
+	std::uintptr_t gcCount_;
+#endif // !NDEBUG
+};
+
+inline Fresh<RefArray> allocateRefArrayFresh(OMR::GC::RunContext& cx, std::size_t nrefs, Site site) {
+	return Fresh<RefArray>(cx, allocateRefArray(cx, nrefs, site));
+}
+
+inline Fresh<Record> allocateRecordFresh(OMR::GC::RunContext& cx, std::size_t nwords, std::uint64_t refMap) {
+	return Fresh<Record>(cx, allocateRecord(cx, nwords, refMap));
+}
+
+inline Fresh<ValueArray> allocateValueArrayFresh(OMR::GC::RunContext& cx, std::size_t length,
+                                                 std::size_t stride, std::uint64_t refMap) {
+	return Fresh<ValueArray>(cx, allocateValueArray(cx, length, stride, refMap));
+}
+
+/// Return a handle to array.data[index]
+inline SlotHandle at(RefArray& array, std::size_t index) {
+	return SlotHandle(&array.data[index]);
+}
+
+/// Store a ref to array->data[index]
+template <typename Barrier = DefaultBarrier>
+inline void store(OMR::GC::RunContext& cx, RefArray& array,
+                  std::size_t index, AnyArray* value) {
+	static_assert(isUsableBarrier<Barrier>(), "this barrier skips work the collector needs");
+	regionStore(cx, &array, value);
+	Barrier::store(cx, (AnyArray*)&array, at(array, index), value);
+}
+
+/// Load the ref in array->data[index]
+inline AnyArray* load(RefArray& array, std::size_t index) {
+	return at(array, index).readReference();
+}
+
+/// Atomically replace the ref in slot with value, if the slot holds expected. Returns the
+/// ref the slot held.
+inline AnyArray* compareExchangeSlot(RefSlot* slot, AnyArray* expected, AnyArray* value) {
+#if defined(OMR_GC_COMPRESSED_POINTERS)
+	return decompress(VM_AtomicSupport::lockCompareExchangeU32(
+		slot, compress(expected), compress(value)));
+#else // OMR_GC_COMPRESSED_POINTERS
+	return reinterpret_cast<AnyArray*>(VM_AtomicSupport::lockCompareExchange(
+		reinterpret_cast<volatile std::uintptr_t*>(slot),
+		reinterpret_cast<std::uintptr_t>(expected),
+		reinterpret_cast<std::uintptr_t>(value)));
+#endif // OMR_GC_COMPRESSED_POINTERS
+}
+
+/// Atomically store value to array->data[index], if the slot holds expected. Returns true
+/// if the store happened. The barrier runs only for a successful store.
+///
+/// Neither this nor exchange is a collection point, so no object can move while they run;
+/// expected must have been loaded since the last collection point, or reloaded through a
+/// StackRoot, like any other ref the mutator holds.
+template <typename Barrier = DefaultBarrier>
+inline bool compareAndSwap(OMR::GC::RunContext& cx, RefArray& array, std::size_t index,
+                           AnyArray* expected, AnyArray* value) {
+	static_assert(isUsableBarrier<Barrier>(), "this barrier skips work the collector needs");
+	regionStore(cx, &array, value);
+	if (compareExchangeSlot(&array.data[index], expected, value) != expected) {
+		return false;
+	}
+	Barrier::postStore(cx, (AnyArray*)&array, value);
+	return true;
+}
+
+/// Atomically store value to array->data[index], and return the ref it replaced.
+template <typename Barrier = DefaultBarrier>
+inline AnyArray* exchange(OMR::GC::RunContext& cx, RefArray& array, std::size_t index, AnyArray* value) {
+	static_assert(isUsableBarrier<Barrier>(), "this barrier skips work the collector needs");
+	regionStore(cx, &array, value);
+	RefSlot* slot = &array.data[index];
+	AnyArray* old;
+	do {
+		old = SlotHandle(slot).readReference();
+	} while (compareExchangeSlot(slot, old, value) != old);
+	Barrier::postStore(cx, (AnyArray*)&array, value);
+	return old;
+}
+
+/// Load the ref in array->data[index], ordered before every later load by this thread. Pairs
+/// with compareAndSwap and exchange, so that the fields of an object published by another
+/// thread are seen initialized.
+inline AnyArray* loadAcquire(RefArray& array, std::size_t index) {
+	AnyArray* value = load(array, index);
+	VM_AtomicSupport::readBarrier();
+	return value;
+}
+
+/// Initialize array->data[index] of a just-allocated array, skipping the barrier when it
+/// is not needed.
+template <typename Barrier = DefaultBarrier>
+inline void initStore(OMR::GC::RunContext& cx, const Fresh<RefArray>& array,
+                      std::size_t index, AnyArray* value) {
+	static_assert(isUsableBarrier<Barrier>(), "this barrier skips work the collector needs");
+	array.check(cx);
+	regionStore(cx, array.get(), value);
+	Barrier::initStore(cx, (AnyArray*)array.get(), at(*array, index), value, array.young());
+}
+
+/// Copy the n refs at src->data[srcPos] to dst->data[dstPos], like System.arraycopy. The
+/// ranges may overlap, and src may be dst. The barrier
+/// runs once for dst, rather than once per slot.
+template <typename Barrier = DefaultBarrier>
+inline void arraycopy(OMR::GC::RunContext& cx, RefArray& src, std::size_t srcPos,
+                      RefArray& dst, std::size_t dstPos, std::size_t n) {
+	static_assert(isUsableBarrier<Barrier>(), "this barrier skips work the collector needs");
+	assert(srcPos <= src.length() && n <= src.length() - srcPos);
+	assert(dstPos <= dst.length() && n <= dst.length() - dstPos);
+	if (n == 0) {
+		return;
+	}
+	RefSlot* begin = &dst.data[dstPos];
+	RefSlot* end = begin + n;
+	if (&src != &dst) {
+		regionStore(cx, &dst, &src.data[srcPos], &src.data[srcPos] + n);
+	}
+	// Copy through volatile slots, so that each slot is moved by one word-sized load and
+	// store, and other threads never see a torn reference.
+	volatile RefSlot* to = begin;
+	const volatile RefSlot* from = &src.data[srcPos];
+	if (to < from) {
+		for (std::size_t i = 0; i < n; ++i) {
+			to[i] = from[i];
+		}
+	} else {
+		for (std::size_t i = n; i != 0; --i) {
+			to[i - 1] = from[i - 1];
+		}
+	}
+	Barrier::postBatch(cx, (AnyArray*)&dst, begin, end);
+}
+
+/// Store value to every slot of dst->data[from, to). The barrier runs once for dst,
+/// rather than once per slot.
+template <typename Barrier = DefaultBarrier>
+inline void fill(OMR::GC::RunContext& cx, RefArray& dst, std::size_t from, std::size_t to, AnyArray* value) {
+	static_assert(isUsableBarrier<Barrier>(), "this barrier skips work the collector needs");
+	assert(from <= to && to <= dst.length());
+	if (from == to) {
+		return;
+	}
+	RefSlot* begin = &dst.data[from];
+	RefSlot* end = &dst.data[to];
+	regionStore(cx, &dst, value);
+	RefSlot encoded;
+	SlotHandle(&encoded).writeReference(value);
+	std::fill(begin, end, encoded);
+	if (value != nullptr) {
+		Barrier::postBatch(cx, (AnyArray*)&dst, begin, begin + 1);
+	}
+}
+
+/// Return a handle to the reference in word index of a record.
+inline SlotHandle at(Record& record, std::size_t index) {
+	return SlotHandle(record.slot(index));
+}
+
+/// Store a ref to word index of a record. The word must be a reference word.
+template <typename Barrier = DefaultBarrier>
+inline void store(OMR::GC::RunContext& cx, Record& record,
+                  std::size_t index, AnyArray* value) {
+	static_assert(isUsableBarrier<Barrier>(), "this barrier skips work the collector needs");
+	regionStore(cx, &record, value);
+	Barrier::store(cx, (AnyArray*)&record, at(record, index), value);
+}
+
+/// Initialize word index of a just-allocated record, skipping the barrier when it is not
+/// needed. The word must be a reference word.
+template <typename Barrier = DefaultBarrier>
+inline void initStore(OMR::GC::RunContext& cx, const Fresh<Record>& record,
+                      std::size_t index, AnyArray* value) {
+	static_assert(isUsableBarrier<Barrier>(), "this barrier skips work the collector needs");
+	record.check(cx);
+	regionStore(cx, record.get(), value);
+	Barrier::initStore(cx, (AnyArray*)record.get(), at(*record, index), value, record.young());
+}
+
+/// Load the ref in word index of a record.
+inline AnyArray* load(Record& record, std::size_t index) {
+	return at(record, index).readReference();
+}
+
+/// Return a handle to the reference in word field of element index.
+inline SlotHandle at(ValueArray& array, std::size_t index, std::size_t field) {
+	return SlotHandle(array.slot(index, field));
+}
+
+/// Store a ref to word field of element index. The word must be a reference word.
+template <typename Barrier = DefaultBarrier>
+inline void store(OMR::GC::RunContext& cx, ValueArray& array,
+                  std::size_t index, std::size_t field, AnyArray* value) {
+	static_assert(isUsableBarrier<Barrier>(), "this barrier skips work the collector needs");
+	regionStore(cx, &array, value);
+	Barrier::store(cx, (AnyArray*)&array, at(array, index, field), value);
+}
+
+/// Initialize word field of element index of a just-allocated array, skipping the barrier
+/// when it is not needed. The word must be a reference word.
+template <typename Barrier = DefaultBarrier>
+inline void initStore(OMR::GC::RunContext& cx, const Fresh<ValueArray>& array,
+                      std::size_t index, std::size_t field, AnyArray* value) {
+	static_assert(isUsableBarrier<Barrier>(), "this barrier skips work the collector needs");
+	array.check(cx);
+	regionStore(cx, array.get(), value);
+	Barrier::initStore(cx, (AnyArray*)array.get(), at(*array, index, field), value, array.young());
+}
+
+/// Load the ref in word field of element index.
+inline AnyArray* load(ValueArray& array, std::size_t index, std::size_t field) {
+	return at(array, index, field).readReference();
+}
 
 } // namespace Splash
 
-#endif // endif // SPLASH_BARRIERS_HPP_
+#endif // SPLASH_BARRIERS_HPP_
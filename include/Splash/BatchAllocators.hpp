@@ -0,0 +1,149 @@
+/*******************************************************************************
+ *  Copyright (c) 2018, 2018 IBM and others
+ *
+ *  This program and the accompanying materials are made available under
+ *  the terms of the Eclipse Public License 2.0 which accompanies this
+ *  distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ *  or the Apache License, Version 2.0 which accompanies this distribution and
+ *  is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  This Source Code may also be made available under the following
+ *  Secondary Licenses when the conditions for such availability set
+ *  forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ *  General Public License, version 2 with the GNU Classpath
+ *  Exception [1] and GNU General Public License, version 2 with the
+ *  OpenJDK Assembly Exception [2].
+ *
+ *  [1] https://www.gnu.org/software/classpath/license.html
+ *  [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ *  SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(SPLASH_BATCHALLOCATORS_HPP_)
+#define SPLASH_BATCHALLOCATORS_HPP_
+
+#include <Splash/Allocators.hpp>
+#include <Splash/Arrays.hpp>
+#include <Splash/Barriers.hpp>
+#include <Splash/ThreadLocalHeap.hpp>
+#include <OMR/GC/StackRoot.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace Splash {
+
+/// How to size, initialize and individually allocate the BinArrays of a batch.
+struct BinArrayBatch {
+	static constexpr bool ZEROED = false;
+
+	static std::size_t size(std::size_t nbytes) { return binArraySize(nbytes); }
+
+	static void init(void* memory, std::size_t nbytes, Site site) { new (memory) BinArray(nbytes, site); }
+
+	static AnyArray* allocate(OMR::GC::RunContext& cx, std::size_t nbytes, Site site) {
+		return (AnyArray*)allocateBinArray(cx, nbytes, site);
+	}
+};
+
+/// How to size, initialize and individually allocate the RefArrays of a batch.
+struct RefArrayBatch {
+	static constexpr bool ZEROED = true;
+
+	static std::size_t size(std::size_t nrefs) { return refArraySize(nrefs); }
+
+	static void init(void* memory, std::size_t nrefs, Site site) { new (memory) RefArray(nrefs, site); }
+
+	static AnyArray* allocate(OMR::GC::RunContext& cx, std::size_t nrefs, Site site) {
+		return (AnyArray*)allocateRefArray(cx, nrefs, site);
+	}
+};
+
+/// Allocate count objects described by Batch at site, and store object i to out[first + i].
+///
+/// Each step reserves one block of the TLH for as many of the remaining objects as it
+/// can hold, then initializes their headers and stores them in a single pass. When the
+/// TLH cannot hold the next object, or shouldPretenure picks it by size or by site, that
+/// object is allocated out of line, which may refresh the TLH or collect. Every object is
+/// counted against site, as a single allocation would be. The new objects are only ever
+/// referenced from out, so no raw pointers are held across a collection.
+///
+/// @returns the number of objects allocated. Less than count only if the heap is exhausted.
+template <typename Batch>
+std::size_t allocateBatch(OMR::GC::RunContext& cx, const std::size_t* lengths, std::size_t count,
+                          OMR::GC::StackRoot<RefArray>& out, std::size_t first, Site site) {
+	assert(first + count <= out->length());
+
+	std::size_t done = 0;
+	while (done < count) {
+		// Find the run of objects that fits in what is left of the TLH.
+		std::size_t available = tlhAvailable(cx, Batch::ZEROED);
+		std::size_t total = 0;
+		std::size_t n = 0;
+		while (done + n < count) {
+			std::size_t sz = Batch::size(lengths[done + n]);
+			if (sz > available - total || shouldPretenure(cx, sz, site)) {
+				break;
+			}
+			total += sz;
+			n += 1;
+		}
+
+		if (n == 0) {
+			AnyArray* object = Batch::allocate(cx, lengths[done], site);
+			if (object == nullptr) {
+				return done;
+			}
+			store(cx, *out, first + done, object);
+			done += 1;
+			continue;
+		}
+
+		std::uint8_t* memory = static_cast<std::uint8_t*>(tlhAllocate(cx, total, Batch::ZEROED));
+		assert(memory != nullptr);
+		// Clear the run following the zeroing strategy, as inlineAllocate does: ahead of
+		// the allocation pointer under CHUNKED, otherwise one object at a time.
+		ZeroingStrategy strategy = zeroingStrategy(cx);
+		if (Batch::ZEROED && strategy == ZeroingStrategy::CHUNKED) {
+			tlhZeroChunked(cx, memory, total);
+		}
+		for (std::size_t i = 0; i < n; ++i) {
+			std::size_t sz = Batch::size(lengths[done + i]);
+			if (Batch::ZEROED && strategy != ZeroingStrategy::CHUNKED) {
+				zeroObject(strategy, memory, sz);
+			}
+			noteAllocation(cx, sz, site);
+			Batch::init(memory, lengths[done + i], site);
+			store(cx, *out, first + done + i, (AnyArray*)memory);
+			memory += sz;
+		}
+		done += n;
+	}
+	return done;
+}
+
+/// Allocate count BinArrays, where BinArray i holds sizes[i] bytes, and store them to
+/// out[first] through out[first + count - 1]. Like allocateBinArray, the data is not zeroed,
+/// and every BinArray is tagged with site.
+/// @returns the number of BinArrays allocated. Less than count only if the heap is exhausted.
+inline std::size_t allocateBinArrays(OMR::GC::RunContext& cx, const std::size_t* sizes, std::size_t count,
+                                     OMR::GC::StackRoot<RefArray>& out, std::size_t first = 0,
+                                     Site site = NO_SITE) {
+	return allocateBatch<BinArrayBatch>(cx, sizes, count, out, first, site);
+}
+
+/// Allocate count RefArrays, where RefArray i holds lengths[i] null slots, and store them
+/// to out[first] through out[first + count - 1]. Every RefArray is tagged with site.
+/// @returns the number of RefArrays allocated. Less than count only if the heap is exhausted.
+inline std::size_t allocateRefArrays(OMR::GC::RunContext& cx, const std::size_t* lengths, std::size_t count,
+                                     OMR::GC::StackRoot<RefArray>& out, std::size_t first = 0,
+                                     Site site = NO_SITE) {
+	return allocateBatch<RefArrayBatch>(cx, lengths, count, out, first, site);
+}
+
+} // namespace Splash
+
+#endif // SPLASH_BATCHALLOCATORS_HPP_
@@ -0,0 +1,122 @@
+/*******************************************************************************
+ *  Copyright (c) 2018, 2018 IBM and others
+ *
+ *  This program and the accompanying materials are made available under
+ *  the terms of the Eclipse Public License 2.0 which accompanies this
+ *  distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ *  or the Apache License, Version 2.0 which accompanies this distribution and
+ *  is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  This Source Code may also be made available under the following
+ *  Secondary Licenses when the conditions for such availability set
+ *  forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ *  General Public License, version 2 with the GNU Classpath
+ *  Exception [1] and GNU General Public License, version 2 with the
+ *  OpenJDK Assembly Exception [2].
+ *
+ *  [1] https://www.gnu.org/software/classpath/license.html
+ *  [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ *  SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(SPLASH_EXTERNAL_HPP_)
+#define SPLASH_EXTERNAL_HPP_
+
+#include <Splash/Arrays.hpp>
+#include <Splash/Region.hpp>
+#include <Splash/ThreadLocalHeap.hpp>
+
+#include "GCExtensionsBase.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // !_WIN32
+
+namespace Splash {
+
+/// A function-like object for initializing ExternalBinArray allocations
+class InitExternalBinArray {
+public:
+	InitExternalBinArray(std::uint8_t* payload, std::uint64_t nbytes, ReleaseFunction release, Site site)
+		: payload_(payload), nbytes_(nbytes), release_(release), site_(site) {}
+
+	void operator()(ExternalBinArray* target) {
+		new (target) ExternalBinArray(payload_, nbytes_, release_, site_);
+	}
+
+private:
+	std::uint8_t* payload_;
+	std::uint64_t nbytes_;
+	ReleaseFunction release_;
+	Site site_;
+};
+
+/// Allocate an ExternalBinArray holding the nbytes at payload, and register it with the
+/// collector. Once a collection finds the array dead, release is called on the payload.
+/// Returns nullptr if the array could not be allocated, in which case the payload is
+/// still owned by the caller.
+inline ExternalBinArray* allocateExternalBinArray(OMR::GC::Context& cx, std::uint8_t* payload, std::uint64_t nbytes,
+                                                  ReleaseFunction release, Site site = NO_SITE) {
+	ExternalBinArray* array = inlineAllocateNonZero<ExternalBinArray>(
+		cx, externalBinArraySize(), InitExternalBinArray(payload, nbytes, release, site), site);
+	if (array != nullptr) {
+		// The registry refers to the array, so it must outlive any region it was allocated in.
+		regionEscape(cx);
+		cx.env()->getExtensions()->objectModel.getObjectModelDelegate()->getExternalArrays()->add(array);
+	}
+	return array;
+}
+
+#if !defined(_WIN32)
+
+/// A ReleaseFunction for payloads mapped with mmap.
+inline void unmapPayload(std::uint8_t* payload, std::uint64_t nbytes) {
+	if (nbytes != 0) {
+		munmap(payload, std::size_t(nbytes));
+	}
+}
+
+/// Map the file at path read-only, and wrap the mapping in an ExternalBinArray that
+/// unmaps it when it dies. The file is never copied into the heap. Returns nullptr if
+/// the file could not be mapped, or the array could not be allocated.
+inline ExternalBinArray* mapFile(OMR::GC::Context& cx, const char* path, Site site = NO_SITE) {
+	int fd = ::open(path, O_RDONLY);
+	if (fd < 0) {
+		return nullptr;
+	}
+	struct stat info;
+	if (fstat(fd, &info) != 0) {
+		::close(fd);
+		return nullptr;
+	}
+	std::uint64_t nbytes = std::uint64_t(info.st_size);
+	void* mapping = nullptr;
+	if (nbytes != 0) {
+		mapping = mmap(nullptr, std::size_t(nbytes), PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	// The mapping holds its own reference to the file.
+	::close(fd);
+	if (mapping == MAP_FAILED) {
+		return nullptr;
+	}
+	ExternalBinArray* array =
+		allocateExternalBinArray(cx, static_cast<std::uint8_t*>(mapping), nbytes, unmapPayload, site);
+	if (array == nullptr) {
+		unmapPayload(static_cast<std::uint8_t*>(mapping), nbytes);
+	}
+	return array;
+}
+
+#endif // !_WIN32
+
+} // namespace Splash
+
+#endif // SPLASH_EXTERNAL_HPP_
@@ -0,0 +1,199 @@
+/*******************************************************************************
+ *  Copyright (c) 2018, 2018 IBM and others
+ *
+ *  This program and the accompanying materials are made available under
+ *  the terms of the Eclipse Public License 2.0 which accompanies this
+ *  distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ *  or the Apache License, Version 2.0 which accompanies this distribution and
+ *  is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  This Source Code may also be made available under the following
+ *  Secondary Licenses when the conditions for such availability set
+ *  forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ *  General Public License, version 2 with the GNU Classpath
+ *  Exception [1] and GNU General Public License, version 2 with the
+ *  OpenJDK Assembly Exception [2].
+ *
+ *  [1] https://www.gnu.org/software/classpath/license.html
+ *  [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ *  SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(SPLASH_KERNELS_HPP_)
+#define SPLASH_KERNELS_HPP_
+
+#include <Splash/Arrays.hpp>
+
+#include <cassert>
+#include <cstddef>
+
+/// Numeric kernels over typed primitive arrays.
+///
+/// The kernels are written in lane-parallel form: each loop keeps one accumulator per
+/// vector lane, so the compiler can map the loop body directly onto SSE2/AVX2/NEON
+/// registers without reassociating floating point math. Payloads are known to be
+/// ALIGNMENT aligned, which is passed on to the compiler.
+///
+/// None of these kernels allocate, so arrays may be passed by plain reference.
+
+namespace Splash {
+
+/// The number of elements of T in a 256 bit vector.
+template <typename T>
+struct Lanes {
+	static constexpr std::size_t value = 32 / sizeof(T);
+};
+
+/// Tell the compiler that p is aligned to the payload alignment of a typed array.
+template <typename T>
+inline T* assumeAligned(T* p) {
+#if defined(__GNUC__)
+	return static_cast<T*>(__builtin_assume_aligned(p, ALIGNMENT));
+#else
+	return p;
+#endif
+}
+
+/// Sum every element.
+template <typename T>
+inline T sum(const PrimArray<T>& array) {
+	constexpr std::size_t L = Lanes<T>::value;
+	const T* p = assumeAligned(array.begin());
+	const std::size_t n = array.length();
+
+	T acc[L] = {};
+	std::size_t i = 0;
+	for (; i + L <= n; i += L) {
+		for (std::size_t j = 0; j < L; ++j) {
+			acc[j] += p[i + j];
+		}
+	}
+
+	T result = 0;
+	for (std::size_t j = 0; j < L; ++j) {
+		result += acc[j];
+	}
+	for (; i < n; ++i) {
+		result += p[i];
+	}
+	return result;
+}
+
+/// Find the smallest element. The array must not be empty.
+template <typename T>
+inline T minimum(const PrimArray<T>& array) {
+	constexpr std::size_t L = Lanes<T>::value;
+	const T* p = assumeAligned(array.begin());
+	const std::size_t n = array.length();
+	assert(n > 0);
+
+	T acc[L];
+	for (std::size_t j = 0; j < L; ++j) {
+		acc[j] = p[0];
+	}
+	std::size_t i = 0;
+	for (; i + L <= n; i += L) {
+		for (std::size_t j = 0; j < L; ++j) {
+			acc[j] = p[i + j] < acc[j] ? p[i + j] : acc[j];
+		}
+	}
+
+	T result = acc[0];
+	for (std::size_t j = 1; j < L; ++j) {
+		result = acc[j] < result ? acc[j] : result;
+	}
+	for (; i < n; ++i) {
+		result = p[i] < result ? p[i] : result;
+	}
+	return result;
+}
+
+/// Find the largest element. The array must not be empty.
+template <typename T>
+inline T maximum(const PrimArray<T>& array) {
+	constexpr std::size_t L = Lanes<T>::value;
+	const T* p = assumeAligned(array.begin());
+	const std::size_t n = array.length();
+	assert(n > 0);
+
+	T acc[L];
+	for (std::size_t j = 0; j < L; ++j) {
+		acc[j] = p[0];
+	}
+	std::size_t i = 0;
+	for (; i + L <= n; i += L) {
+		for (std::size_t j = 0; j < L; ++j) {
+			acc[j] = p[i + j] > acc[j] ? p[i + j] : acc[j];
+		}
+	}
+
+	T result = acc[0];
+	for (std::size_t j = 1; j < L; ++j) {
+		result = acc[j] > result ? acc[j] : result;
+	}
+	for (; i < n; ++i) {
+		result = p[i] > result ? p[i] : result;
+	}
+	return result;
+}
+
+/// The dot product of two arrays of equal length.
+template <typename T>
+inline T dot(const PrimArray<T>& lhs, const PrimArray<T>& rhs) {
+	constexpr std::size_t L = Lanes<T>::value;
+	const T* a = assumeAligned(lhs.begin());
+	const T* b = assumeAligned(rhs.begin());
+	const std::size_t n = lhs.length();
+	assert(rhs.length() == n);
+
+	T acc[L] = {};
+	std::size_t i = 0;
+	for (; i + L <= n; i += L) {
+		for (std::size_t j = 0; j < L; ++j) {
+			acc[j] += a[i + j] * b[i + j];
+		}
+	}
+
+	T result = 0;
+	for (std::size_t j = 0; j < L; ++j) {
+		result += acc[j];
+	}
+	for (; i < n; ++i) {
+		result += a[i] * b[i];
+	}
+	return result;
+}
+
+/// Set every element to value.
+template <typename T>
+inline void fill(PrimArray<T>& array, T value) {
+	T* p = assumeAligned(array.begin());
+	const std::size_t n = array.length();
+	for (std::size_t i = 0; i < n; ++i) {
+		p[i] = value;
+	}
+}
+
+/// Compare every element against value. Writes 1 to mask.data[i] where element i
+/// equals value, 0 elsewhere. The mask must hold at least one byte per element.
+/// @returns the number of equal elements.
+template <typename T>
+inline std::size_t compareEqual(const PrimArray<T>& array, T value, BinArray& mask) {
+	const T* p = assumeAligned(array.begin());
+	const std::size_t n = array.length();
+	assert(mask.header.length() >= n);
+
+	std::uint8_t* out = mask.data;
+	std::size_t count = 0;
+	for (std::size_t i = 0; i < n; ++i) {
+		std::uint8_t equal = p[i] == value;
+		out[i] = equal;
+		count += equal;
+	}
+	return count;
+}
+
+} // namespace Splash
+
+#endif // SPLASH_KERNELS_HPP_
@@ -0,0 +1,97 @@
+/*******************************************************************************
+ *  Copyright (c) 2018, 2018 IBM and others
+ *
+ *  This program and the accompanying materials are made available under
+ *  the terms of the Eclipse Public License 2.0 which accompanies this
+ *  distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ *  or the Apache License, Version 2.0 which accompanies this distribution and
+ *  is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  This Source Code may also be made available under the following
+ *  Secondary Licenses when the conditions for such availability set
+ *  forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ *  General Public License, version 2 with the GNU Classpath
+ *  Exception [1] and GNU General Public License, version 2 with the
+ *  OpenJDK Assembly Exception [2].
+ *
+ *  [1] https://www.gnu.org/software/classpath/license.html
+ *  [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ *  SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(SPLASH_PRETENURE_HPP_)
+#define SPLASH_PRETENURE_HPP_
+
+#include <Splash/Arrays.hpp>
+#include <Splash/Zeroing.hpp>
+
+#include <OMR/GC/System.hpp>
+
+#include "omrcfg.h"
+#if defined(OMR_GC_MODRON_SCAVENGER)
+#include "omrgc.h"
+#include "EnvironmentBase.hpp"
+#include "EnvironmentDelegate.hpp"
+#include "GCExtensionsBase.hpp"
+#include "ObjectAllocationModel.hpp"
+#endif // OMR_GC_MODRON_SCAVENGER
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Splash {
+
+/// True if an object of size bytes, allocated at site, should skip the nursery and be
+/// allocated directly in tenure. Large arrays would otherwise be copied by the scavenger
+/// before they tenure. The size is set with -XpretenureThreshold:<bytes>. Sites are
+/// pretenured once their objects are seen to survive scavenges. Always false without a
+/// scavenger.
+inline bool shouldPretenure(OMR::GC::Context& cx, std::size_t size, Site site = NO_SITE) {
+#if defined(OMR_GC_MODRON_SCAVENGER)
+	GC_ObjectModelDelegate* delegate = cx.env()->getExtensions()->objectModel.getObjectModelDelegate();
+	return size >= delegate->getPretenureThreshold()
+	    || (site != NO_SITE && delegate->getAllocationSites()->isPretenured(site));
+#else // OMR_GC_MODRON_SCAVENGER
+	return false;
+#endif // OMR_GC_MODRON_SCAVENGER
+}
+
+/// Count size bytes allocated at site by the calling thread, for survival feedback.
+inline void noteAllocation(OMR::GC::Context& cx, std::size_t size, Site site) {
+#if defined(OMR_GC_MODRON_SCAVENGER)
+	if (site != NO_SITE) {
+		cx.env()->getGCEnvironment()->siteAllocatedBytes[site] += size;
+	}
+#endif // OMR_GC_MODRON_SCAVENGER
+}
+
+/// Allocate an object directly in tenure, and initialize it with init. The object is
+/// zeroed first, following the zeroing strategy, if zeroed is set. May collect. Returns nullptr if the heap is exhausted.
+///
+/// Stores into the object must still go through Splash::store: the object is old from the
+/// start, so the generational barrier remembers it when a young reference is stored.
+template <typename T, typename Init>
+inline T* tenureAllocate(OMR::GC::Context& cx, std::size_t size, bool zeroed, Init&& init) {
+#if defined(OMR_GC_MODRON_SCAVENGER)
+	MM_EnvironmentBase* env = cx.env();
+	MM_ObjectAllocationModel allocationModel(env, size, OMR_GC_ALLOCATE_OBJECT_TENURED);
+	void* memory = OMR_GC_AllocateObject(env->getOmrVMThread(), &allocationModel);
+	if (memory == nullptr) {
+		return nullptr;
+	}
+	if (zeroed) {
+		zeroObject(env->getExtensions()->objectModel.getObjectModelDelegate()->getZeroingStrategy(), memory, size);
+	}
+	T* object = static_cast<T*>(memory);
+	init(object);
+	env->getExtensions()->objectModel.getObjectModelDelegate()->addPretenuredBytes(size);
+	return object;
+#else // OMR_GC_MODRON_SCAVENGER
+	return nullptr;
+#endif // OMR_GC_MODRON_SCAVENGER
+}
+
+} // namespace Splash
+
+#endif // SPLASH_PRETENURE_HPP_
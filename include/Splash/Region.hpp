@@ -0,0 +1,249 @@
+/*******************************************************************************
+ *  Copyright (c) 2018, 2018 IBM and others
+ *
+ *  This program and the accompanying materials are made available under
+ *  the terms of the Eclipse Public License 2.0 which accompanies this
+ *  distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ *  or the Apache License, Version 2.0 which accompanies this distribution and
+ *  is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  This Source Code may also be made available under the following
+ *  Secondary Licenses when the conditions for such availability set
+ *  forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ *  General Public License, version 2 with the GNU Classpath
+ *  Exception [1] and GNU General Public License, version 2 with the
+ *  OpenJDK Assembly Exception [2].
+ *
+ *  [1] https://www.gnu.org/software/classpath/license.html
+ *  [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ *  SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(SPLASH_REGION_HPP_)
+#define SPLASH_REGION_HPP_
+
+#include <Splash/Arrays.hpp>
+
+#include <OMR/GC/StackRoot.hpp>
+#include <OMR/GC/System.hpp>
+
+#include "omrcfg.h"
+#include "EnvironmentBase.hpp"
+#include "EnvironmentDelegate.hpp"
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+#include "LanguageThreadLocalHeap.hpp"
+#endif // OMR_GC_THREAD_LOCAL_HEAP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Splash {
+
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+
+/// The region mark of the TLH selected by zeroed.
+inline GC_RegionMark* regionMark(GC_Environment* gcEnv, bool zeroed) {
+	return zeroed ? &gcEnv->regionMark : &gcEnv->nonZeroRegionMark;
+}
+
+/// True if address lies in the part of the TLH selected by zeroed allocated since the
+/// region opened.
+inline bool inRegion(MM_EnvironmentBase* env, GC_Environment* gcEnv, bool zeroed, const void* address) {
+	const std::uint8_t* p = static_cast<const std::uint8_t*>(address);
+	return regionMark(gcEnv, zeroed)->heapAlloc <= p
+	    && p < *env->getLanguageThreadLocalHeap()->getPointerToHeapAlloc(env, zeroed);
+}
+
+/// True if address lies in the open region, in either TLH.
+inline bool inRegion(MM_EnvironmentBase* env, GC_Environment* gcEnv, const void* address) {
+	return inRegion(env, gcEnv, true, address) || inRegion(env, gcEnv, false, address);
+}
+
+#endif // OMR_GC_THREAD_LOCAL_HEAP
+
+/// The escape check of the write barrier. Called before storing value into object: if the
+/// calling thread has a region open and value was allocated in it, while object was not,
+/// the region has escaped and will not be reclaimed.
+inline void regionStore(OMR::GC::RunContext& cx, const void* object, const void* value) {
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+	MM_EnvironmentBase* env = cx.env();
+	GC_Environment* gcEnv = env->getGCEnvironment();
+	if (gcEnv->regionDepth != 0 && !gcEnv->regionEscaped
+	    && inRegion(env, gcEnv, value) && !inRegion(env, gcEnv, object)) {
+		gcEnv->regionEscaped = true;
+	}
+#endif // OMR_GC_THREAD_LOCAL_HEAP
+}
+
+/// The escape check for a batch of stores: the refs in [begin, end) are about to be
+/// copied into object.
+inline void regionStore(OMR::GC::RunContext& cx, const void* object, const RefSlot* begin, const RefSlot* end) {
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+	MM_EnvironmentBase* env = cx.env();
+	GC_Environment* gcEnv = env->getGCEnvironment();
+	if (gcEnv->regionDepth != 0 && !gcEnv->regionEscaped && !inRegion(env, gcEnv, object)) {
+		for (const RefSlot* slot = begin; slot != end; ++slot) {
+			if (inRegion(env, gcEnv, SlotHandle(const_cast<RefSlot*>(slot)).readReference())) {
+				gcEnv->regionEscaped = true;
+				return;
+			}
+		}
+	}
+#endif // OMR_GC_THREAD_LOCAL_HEAP
+}
+
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+
+/// True if a stack root of the calling thread refers to an object in the open region. A
+/// region that is still reachable from a root when it closes has escaped.
+inline bool rootsInRegion(OMR::GC::Context& cx) {
+	MM_EnvironmentBase* env = cx.env();
+	GC_Environment* gcEnv = env->getGCEnvironment();
+	for (void* root : cx.stackRoots()) {
+		if (root != nullptr && inRegion(env, gcEnv, root)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+#endif // OMR_GC_THREAD_LOCAL_HEAP
+
+/// Give up reclaiming the region open on the calling thread, if any, because an object
+/// allocated in it is about to be referenced from somewhere the write barrier does not see.
+inline void regionEscape(OMR::GC::Context& cx) {
+	GC_Environment* gcEnv = cx.env()->getGCEnvironment();
+	if (gcEnv->regionDepth != 0) {
+		gcEnv->regionEscaped = true;
+	}
+}
+
+/// A scoped allocation region.
+///
+/// While a Region is open, objects allocated inline from the thread's TLHs are carved out
+/// of the memory following the allocation pointers at the time the region opened. When the
+/// region closes, if none of those objects escaped, the allocation pointers are wound back
+/// to where they were, reclaiming every object in one step. Otherwise the region is simply
+/// abandoned, and its objects are left to the GC like any others.
+///
+/// Escapes through the heap are caught by the write barrier, in Splash::store, and escapes
+/// through StackRoots are caught when the region closes. A GC or a TLH refresh while the
+/// region is open also prevents reclamation. Raw pointers, including return values, are
+/// NOT seen: call escape() before one outlives the region. Debug builds poison reclaimed
+/// memory, so that such a pointer fails fast. Objects allocated out of line, or in tenure,
+/// are never part of the region. Regions may nest; only the outermost one is reclaimed.
+class Region {
+public:
+	/// The byte debug builds fill reclaimed memory with.
+	static constexpr std::uint8_t REGION_POISON = 0xdb;
+
+	explicit Region(OMR::GC::Context& cx) : cx_(cx), open_(true) {
+		MM_EnvironmentBase* env = cx_.env();
+		GC_Environment* gcEnv = env->getGCEnvironment();
+		if (gcEnv->regionDepth++ == 0) {
+			gcEnv->regionEscaped = false;
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+			mark(env, gcEnv, true);
+			mark(env, gcEnv, false);
+#endif // OMR_GC_THREAD_LOCAL_HEAP
+		}
+	}
+
+	Region(const Region&) = delete;
+
+	Region& operator=(const Region&) = delete;
+
+	~Region() {
+		if (open_) {
+			close();
+		}
+	}
+
+	/// Give up reclaiming the region, because one of its objects is about to be stored
+	/// somewhere the write barrier does not see, such as a root that outlives the region.
+	void escape() { regionEscape(cx_); }
+
+	/// True if no object allocated in the region is known to have escaped yet.
+	bool contained() const { return !cx_.env()->getGCEnvironment()->regionEscaped; }
+
+	/// Close the region. Returns true if its objects were reclaimed. Closing a closed region
+	/// does nothing.
+	bool close() {
+		if (!open_) {
+			return false;
+		}
+		MM_EnvironmentBase* env = cx_.env();
+		GC_Environment* gcEnv = env->getGCEnvironment();
+		open_ = false;
+		if (--gcEnv->regionDepth != 0 || gcEnv->regionEscaped) {
+			return false;
+		}
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+		if (rootsInRegion(cx_)) {
+			gcEnv->regionEscaped = true;
+			return false;
+		}
+		if (reclaimable(env, gcEnv, true) && reclaimable(env, gcEnv, false)) {
+			reclaim(env, gcEnv, true);
+			reclaim(env, gcEnv, false);
+			return true;
+		}
+#endif // OMR_GC_THREAD_LOCAL_HEAP
+		return false;
+	}
+
+private:
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+	static void mark(MM_EnvironmentBase* env, GC_Environment* gcEnv, bool zeroed) {
+		MM_LanguageThreadLocalHeap* tlh = env->getLanguageThreadLocalHeap();
+		GC_RegionMark* mark = regionMark(gcEnv, zeroed);
+		mark->heapBase = tlh->getLanguageThreadLocalHeapStruct(env, zeroed)->heapBase;
+		mark->heapAlloc = *tlh->getPointerToHeapAlloc(env, zeroed);
+	}
+
+	/// True if the TLH is still the one the region opened in, and inline allocation from
+	/// it is enabled, so every object allocated from it in the region lies between the mark
+	/// and the allocation pointer.
+	static bool reclaimable(MM_EnvironmentBase* env, GC_Environment* gcEnv, bool zeroed) {
+		MM_LanguageThreadLocalHeap* tlh = env->getLanguageThreadLocalHeap();
+		LanguageThreadLocalHeapStruct* tlhStruct = tlh->getLanguageThreadLocalHeapStruct(env, zeroed);
+		GC_RegionMark* mark = regionMark(gcEnv, zeroed);
+		return tlhStruct->heapBase == mark->heapBase && tlhStruct->realHeapAlloc == nullptr
+		    && mark->heapAlloc <= *tlh->getPointerToHeapAlloc(env, zeroed);
+	}
+
+	/// Wind the allocation pointer of the TLH back to the mark.
+	static void reclaim(MM_EnvironmentBase* env, GC_Environment* gcEnv, bool zeroed) {
+		MM_LanguageThreadLocalHeap* tlh = env->getLanguageThreadLocalHeap();
+		std::uint8_t** alloc = tlh->getPointerToHeapAlloc(env, zeroed);
+		std::uint8_t* mark = regionMark(gcEnv, zeroed)->heapAlloc;
+#if defined(OMR_GC_BATCH_CLEAR_TLH)
+		const bool clear = zeroed;
+#else // OMR_GC_BATCH_CLEAR_TLH
+		const bool clear = false;
+#endif // OMR_GC_BATCH_CLEAR_TLH
+		if (clear) {
+			// OMR expects the rest of a zeroed TLH to be clear.
+			std::memset(mark, 0, std::size_t(*alloc - mark));
+		} else {
+#if !defined(NDEBUG)
+			std::memset(mark, REGION_POISON, std::size_t(*alloc - mark));
+#endif // !NDEBUG
+		}
+		*alloc = mark;
+		if (zeroed) {
+			// The memory handed back is dirty: chunked zeroing must clear it again.
+			*tlh->getPointerToHeapZeroed(env) = nullptr;
+		}
+	}
+#endif // OMR_GC_THREAD_LOCAL_HEAP
+
+	OMR::GC::Context& cx_;
+	bool open_;
+};
+
+} // namespace Splash
+
+#endif // SPLASH_REGION_HPP_
@@ -0,0 +1,349 @@
+/*******************************************************************************
+ *  Copyright (c) 2018, 2018 IBM and others
+ *
+ *  This program and the accompanying materials are made available under
+ *  the terms of the Eclipse Public License 2.0 which accompanies this
+ *  distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ *  or the Apache License, Version 2.0 which accompanies this distribution and
+ *  is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  This Source Code may also be made available under the following
+ *  Secondary Licenses when the conditions for such availability set
+ *  forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ *  General Public License, version 2 with the GNU Classpath
+ *  Exception [1] and GNU General Public License, version 2 with the
+ *  OpenJDK Assembly Exception [2].
+ *
+ *  [1] https://www.gnu.org/software/classpath/license.html
+ *  [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ *  SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(SPLASH_THREADLOCALHEAP_HPP_)
+#define SPLASH_THREADLOCALHEAP_HPP_
+
+#include <Splash/Pretenure.hpp>
+#include <Splash/Zeroing.hpp>
+
+#include <OMR/GC/Allocator.hpp>
+#include <OMR/GC/System.hpp>
+
+#include "omrcfg.h"
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+#include "LanguageThreadLocalHeap.hpp"
+#endif // OMR_GC_THREAD_LOCAL_HEAP
+#if defined(OMR_GC_SEGREGATED_HEAP)
+#include "LanguageSegregatedAllocationCache.hpp"
+#endif // OMR_GC_SEGREGATED_HEAP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace Splash {
+
+/// Bytes allocated between prefetches ahead of the TLH allocation pointer.
+constexpr std::size_t TLH_PREFETCH_STRIDE = 256;
+
+/// The cache line size assumed when prefetching.
+constexpr std::size_t TLH_PREFETCH_LINE = 64;
+
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+
+/// Prefetch the next stride of the TLH, the thread's prefetch distance ahead of alloc, and
+/// reset the countdown in tlhPrefetchFTA. A thread that does not prefetch has its countdown
+/// set past the end of the TLH, so it is not checked again until the next refresh.
+inline void tlhPrefetch(MM_EnvironmentBase* env, MM_LanguageThreadLocalHeap* tlh, bool zeroed,
+                        std::uint8_t* alloc, std::uint8_t* top) {
+	intptr_t* fta = tlh->getPointerToTlhPrefetchFTA(env, zeroed);
+	intptr_t distance = tlh->getLanguageThreadLocalHeapSizingStruct(env, zeroed)->prefetchDistance;
+	if (distance == 0 || top - alloc <= distance) {
+		*fta = top - alloc;
+		return;
+	}
+	std::uint8_t* end = alloc + distance + TLH_PREFETCH_STRIDE;
+	if (top < end) {
+		end = top;
+	}
+	for (std::uint8_t* line = alloc + distance; line < end; line += TLH_PREFETCH_LINE) {
+#if defined(__GNUC__)
+		__builtin_prefetch(line, 1);
+#endif
+	}
+	*fta = TLH_PREFETCH_STRIDE;
+}
+
+#endif // OMR_GC_THREAD_LOCAL_HEAP
+
+/// Bump-allocate size bytes from the calling thread's thread local heap (TLH).
+/// Returns nullptr if the TLH does not have room, or if inline allocation has been
+/// disabled by the collector, which makes the TLH look full. Never collects.
+///
+/// zeroed selects the TLH: with OMR_GC_NON_ZERO_TLH, non-zeroed allocations come from
+/// a separate TLH. The memory returned is NOT cleared.
+inline void* tlhAllocate(OMR::GC::Context& cx, std::size_t size, bool zeroed) {
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+	MM_EnvironmentBase* env = cx.env();
+	MM_LanguageThreadLocalHeap* tlh = env->getLanguageThreadLocalHeap();
+	std::uint8_t** alloc = tlh->getPointerToHeapAlloc(env, zeroed);
+	std::uint8_t* top = *tlh->getPointerToHeapTop(env, zeroed);
+	std::uint8_t* result = *alloc;
+	if (size <= std::size_t(top - result)) {
+		*alloc = result + size;
+#if defined(OMR_GC_TLH_PREFETCH_FTA)
+		intptr_t* fta = tlh->getPointerToTlhPrefetchFTA(env, zeroed);
+		*fta -= intptr_t(size);
+		if (*fta < 0) {
+			tlhPrefetch(env, tlh, zeroed, result + size, top);
+		}
+#endif // OMR_GC_TLH_PREFETCH_FTA
+		return result;
+	}
+#endif // OMR_GC_THREAD_LOCAL_HEAP
+	return nullptr;
+}
+
+/// The number of bytes left in the calling thread's TLH. Zero if inline allocation is
+/// disabled.
+inline std::size_t tlhAvailable(OMR::GC::Context& cx, bool zeroed) {
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+	MM_EnvironmentBase* env = cx.env();
+	MM_LanguageThreadLocalHeap* tlh = env->getLanguageThreadLocalHeap();
+	return std::size_t(*tlh->getPointerToHeapTop(env, zeroed) - *tlh->getPointerToHeapAlloc(env, zeroed));
+#else // OMR_GC_THREAD_LOCAL_HEAP
+	return 0;
+#endif // OMR_GC_THREAD_LOCAL_HEAP
+}
+
+/// The number of times the calling thread's TLH has been refreshed by the Splash allocators.
+inline std::size_t tlhRefreshCount(OMR::GC::Context& cx, bool zeroed) {
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+	MM_EnvironmentBase* env = cx.env();
+	return env->getLanguageThreadLocalHeap()->getLanguageThreadLocalHeapSizingStruct(env, zeroed)->refreshCount;
+#else // OMR_GC_THREAD_LOCAL_HEAP
+	return 0;
+#endif // OMR_GC_THREAD_LOCAL_HEAP
+}
+
+/// The number of TLH refreshes that failed, leaving the calling thread without a TLH.
+inline std::size_t tlhRefreshFailures(OMR::GC::Context& cx, bool zeroed) {
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+	MM_EnvironmentBase* env = cx.env();
+	return env->getLanguageThreadLocalHeap()->getLanguageThreadLocalHeapSizingStruct(env, zeroed)->refreshFailures;
+#else // OMR_GC_THREAD_LOCAL_HEAP
+	return 0;
+#endif // OMR_GC_THREAD_LOCAL_HEAP
+}
+
+/// The refresh size chosen for the calling thread's TLH by the adaptive sizing policy.
+/// Zero until the first GC, or if the policy is disabled.
+inline std::size_t tlhRefreshSize(OMR::GC::Context& cx, bool zeroed) {
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+	MM_EnvironmentBase* env = cx.env();
+	return env->getLanguageThreadLocalHeap()->getLanguageThreadLocalHeapSizingStruct(env, zeroed)->refreshSize;
+#else // OMR_GC_THREAD_LOCAL_HEAP
+	return 0;
+#endif // OMR_GC_THREAD_LOCAL_HEAP
+}
+
+/// Call allocate, an out-of-line allocation of size bytes that may refresh the TLH selected
+/// by zeroed. The refresh size chosen by the sizing policy is applied first, since OMR grows
+/// the refresh size on its own; afterwards, the refresh or refresh failure is counted.
+template <typename Allocate>
+inline auto tlhRefreshAllocate(OMR::GC::Context& cx, std::size_t size, bool zeroed, Allocate&& allocate)
+	-> decltype(allocate()) {
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+	MM_EnvironmentBase* env = cx.env();
+	MM_LanguageThreadLocalHeap* tlh = env->getLanguageThreadLocalHeap();
+	LanguageThreadLocalHeapStruct* tlhStruct = tlh->getLanguageThreadLocalHeapStruct(env, zeroed);
+	LanguageThreadLocalHeapSizingStruct* sizing = tlh->getLanguageThreadLocalHeapSizingStruct(env, zeroed);
+	if (sizing->refreshSize != 0) {
+		tlhStruct->refreshSize = sizing->refreshSize;
+	}
+	std::uint8_t* base = tlhStruct->heapBase;
+	std::size_t refreshSize = tlhStruct->refreshSize;
+
+	auto result = allocate();
+
+	std::uint8_t* top = *tlh->getPointerToHeapTop(env, zeroed);
+	if (tlhStruct->heapBase != base && tlhStruct->heapBase != nullptr) {
+		sizing->refreshCount += 1;
+		sizing->cycleRefreshes += 1;
+		sizing->cycleBytes += std::size_t(top - tlhStruct->heapBase);
+		*tlh->getPointerToTlhPrefetchFTA(env, zeroed) = 0;
+	} else if (tlhStruct->heapBase == nullptr && size <= refreshSize / 2) {
+		// OMR dropped the TLH to refresh it, but the heap could not supply another. An
+		// allocation OMR chose to serve outside the TLH leaves the TLH in place.
+		sizing->refreshFailures += 1;
+		sizing->cycleFailures += 1;
+	}
+	return result;
+#else // OMR_GC_THREAD_LOCAL_HEAP
+	return allocate();
+#endif // OMR_GC_THREAD_LOCAL_HEAP
+}
+
+/// Allocate a cell of the size class fitting size bytes from the calling thread's
+/// segregated allocation cache. Returns nullptr if the cache for that class is empty,
+/// if the object is too large for the small classes, or if the heap is not segregated.
+/// Never collects. The memory returned is NOT cleared.
+inline void* segregatedAllocate(OMR::GC::Context& cx, std::size_t size) {
+#if defined(OMR_GC_SEGREGATED_HEAP)
+	if (size < OMR_SIZECLASSES_MAX_SMALL_SIZE_BYTES) {
+		MM_EnvironmentBase* env = cx.env();
+		OMR_SizeClasses* sizeClasses = MM_LanguageSegregatedAllocationCache::getSizeClasses();
+		std::uintptr_t sizeClass = sizeClasses->sizeClassIndex[size >> 2];
+		std::size_t cellSize = sizeClasses->smallCellSizes[sizeClass];
+		LanguageSegregatedAllocationCacheEntryStruct* entry =
+			&env->getLanguageSegregatedAllocationCache()->getLanguageSegregatedAllocationCacheStruct(env)[sizeClass];
+		std::uint8_t* result = reinterpret_cast<std::uint8_t*>(entry->current);
+		std::uint8_t* top = reinterpret_cast<std::uint8_t*>(entry->top);
+		if (cellSize <= std::size_t(top - result)) {
+			entry->current = reinterpret_cast<std::uintptr_t*>(result + cellSize);
+			return result;
+		}
+	}
+#endif // OMR_GC_SEGREGATED_HEAP
+	return nullptr;
+}
+
+/// Allocate size bytes from whichever inline fast path the heap supports: the TLH,
+/// or the segregated allocation cache. Returns nullptr if both are exhausted.
+inline void* fastAllocate(OMR::GC::Context& cx, std::size_t size, bool zeroed) {
+	void* memory = tlhAllocate(cx, size, zeroed);
+#if defined(OMR_GC_SEGREGATED_HEAP)
+	if (memory == nullptr) {
+		memory = segregatedAllocate(cx, size);
+	}
+#endif // OMR_GC_SEGREGATED_HEAP
+	return memory;
+}
+
+/// The zeroing strategy selected with -XzeroStrategy:.
+inline ZeroingStrategy zeroingStrategy(OMR::GC::Context& cx) {
+	return cx.env()->getExtensions()->objectModel.getObjectModelDelegate()->getZeroingStrategy();
+}
+
+/// Clear the zeroed TLH a chunk at a time, just ahead of the allocation pointer, until the
+/// size bytes just allocated at memory are clear. Chunks are cleared shortly before they
+/// are used, so they are still in the cache when the objects in them are initialized.
+inline void tlhZeroChunked(OMR::GC::Context& cx, void* memory, std::size_t size) {
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+	MM_EnvironmentBase* env = cx.env();
+	MM_LanguageThreadLocalHeap* tlh = env->getLanguageThreadLocalHeap();
+	std::uint8_t** zeroed = tlh->getPointerToHeapZeroed(env);
+	std::uint8_t* top = *tlh->getPointerToHeapTop(env, true);
+	std::uint8_t* begin = static_cast<std::uint8_t*>(memory);
+	std::uint8_t* end = begin + size;
+
+	if (*zeroed < begin || top < *zeroed) {
+		// The TLH has been refreshed, or cleared by someone else. Start again from here.
+		*zeroed = begin;
+	}
+	if (*zeroed < end) {
+		std::uint8_t* limit = reinterpret_cast<std::uint8_t*>(
+			align(reinterpret_cast<std::uintptr_t>(end), ZERO_CHUNK_SIZE));
+		if (top < limit) {
+			limit = top;
+		}
+		std::memset(*zeroed, 0, std::size_t(limit - *zeroed));
+		*zeroed = limit;
+	}
+#else // OMR_GC_THREAD_LOCAL_HEAP
+	std::memset(memory, 0, size);
+#endif // OMR_GC_THREAD_LOCAL_HEAP
+}
+
+/// Forget how far ahead the zeroed TLH has been cleared. Called after every out-of-line
+/// allocation, since any of them may refresh the TLH.
+inline void tlhForgetZeroed(OMR::GC::Context& cx) {
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+	MM_EnvironmentBase* env = cx.env();
+	*env->getLanguageThreadLocalHeap()->getPointerToHeapZeroed(env) = nullptr;
+#endif // OMR_GC_THREAD_LOCAL_HEAP
+}
+
+/// Allocate a zeroed object out of line, with OMR::GC::allocate. May collect. Under the
+/// STREAMING strategy, large objects are allocated without zeroing, and cleared with
+/// non-temporal stores instead.
+template <typename T, typename Init>
+inline T* outOfLineAllocate(OMR::GC::Context& cx, std::size_t size, ZeroingStrategy strategy, Init&& init) {
+	T* object;
+	if (strategy == ZeroingStrategy::STREAMING && size >= STREAMING_ZERO_MINIMUM) {
+		object = OMR::GC::allocateNonZero<T>(cx, size, [&](T* target) {
+			zeroNonTemporal(target, size);
+			init(target);
+		});
+	} else {
+		object = tlhRefreshAllocate(cx, size, true, [&]() {
+			return OMR::GC::allocate<T>(cx, size, std::forward<Init>(init));
+		});
+	}
+	tlhForgetZeroed(cx);
+	return object;
+}
+
+/// Allocate a zeroed object, with an inline fast path. Falls back to
+/// OMR::GC::allocate, which may collect, only when the fast path is exhausted.
+/// Objects over the pretenure threshold, or allocated at a pretenured site, are
+/// allocated directly in tenure. The memory is cleared following the zeroing strategy.
+template <typename T, typename Init>
+inline T* inlineAllocate(OMR::GC::Context& cx, std::size_t size, Init&& init, Site site = NO_SITE) {
+	noteAllocation(cx, size, site);
+	if (shouldPretenure(cx, size, site)) {
+		T* object = tenureAllocate<T>(cx, size, true, std::forward<Init>(init));
+		tlhForgetZeroed(cx);
+		return object;
+	}
+	ZeroingStrategy strategy = zeroingStrategy(cx);
+	void* memory = tlhAllocate(cx, size, true);
+	if (memory != nullptr) {
+		if (strategy == ZeroingStrategy::CHUNKED) {
+			tlhZeroChunked(cx, memory, size);
+		} else {
+			zeroObject(strategy, memory, size);
+		}
+	} else {
+		memory = segregatedAllocate(cx, size);
+		if (memory == nullptr) {
+			return outOfLineAllocate<T>(cx, size, strategy, std::forward<Init>(init));
+		}
+		zeroObject(strategy, memory, size);
+	}
+	T* object = static_cast<T*>(memory);
+	init(object);
+	return object;
+}
+
+/// Allocate an object without zeroing it, with an inline fast path. Falls back to
+/// OMR::GC::allocateNonZero, which may collect, only when the fast path is exhausted.
+/// Objects over the pretenure threshold, or allocated at a pretenured site, are
+/// allocated directly in tenure.
+template <typename T, typename Init>
+inline T* inlineAllocateNonZero(OMR::GC::Context& cx, std::size_t size, Init&& init, Site site = NO_SITE) {
+	noteAllocation(cx, size, site);
+	if (shouldPretenure(cx, size, site)) {
+		T* object = tenureAllocate<T>(cx, size, false, std::forward<Init>(init));
+		tlhForgetZeroed(cx);
+		return object;
+	}
+	void* memory = fastAllocate(cx, size, false);
+	if (memory == nullptr) {
+		T* object = tlhRefreshAllocate(cx, size, false, [&]() {
+			return OMR::GC::allocateNonZero<T>(cx, size, std::forward<Init>(init));
+		});
+		tlhForgetZeroed(cx);
+		return object;
+	}
+	T* object = static_cast<T*>(memory);
+	init(object);
+	return object;
+}
+
+} // namespace Splash
+
+#endif // SPLASH_THREADLOCALHEAP_HPP_
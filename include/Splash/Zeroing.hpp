@@ -0,0 +1,90 @@
+/*******************************************************************************
+ *  Copyright (c) 2018, 2018 IBM and others
+ *
+ *  This program and the accompanying materials are made available under
+ *  the terms of the Eclipse Public License 2.0 which accompanies this
+ *  distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ *  or the Apache License, Version 2.0 which accompanies this distribution and
+ *  is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  This Source Code may also be made available under the following
+ *  Secondary Licenses when the conditions for such availability set
+ *  forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ *  General Public License, version 2 with the GNU Classpath
+ *  Exception [1] and GNU General Public License, version 2 with the
+ *  OpenJDK Assembly Exception [2].
+ *
+ *  [1] https://www.gnu.org/software/classpath/license.html
+ *  [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ *  SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(SPLASH_ZEROING_HPP_)
+#define SPLASH_ZEROING_HPP_
+
+#include <Splash/Arrays.hpp>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif // __SSE2__
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Splash {
+
+/// How the allocators clear the memory of objects that must start out zeroed, like
+/// RefArrays. Selected with -XzeroStrategy:object|chunked|streaming.
+enum class ZeroingStrategy : std::uint8_t {
+	/// Clear each object as it is allocated.
+	OBJECT,
+	/// Clear the TLH in ZERO_CHUNK_SIZE chunks, just ahead of the allocation pointer.
+	CHUNKED,
+	/// Clear objects of at least STREAMING_ZERO_MINIMUM bytes with non-temporal stores,
+	/// which do not evict the working set from the cache.
+	STREAMING
+};
+
+/// The unit the CHUNKED strategy clears the TLH in. Small enough to stay in the L1 cache
+/// until the objects allocated in it are initialized.
+constexpr const std::size_t ZERO_CHUNK_SIZE = 16 * 1024;
+
+/// The smallest object the STREAMING strategy clears with non-temporal stores. Smaller
+/// objects are likely to be used while they are still in the cache.
+constexpr const std::size_t STREAMING_ZERO_MINIMUM = 256 * 1024;
+
+/// Clear size bytes at memory with non-temporal stores, which bypass the cache. memory
+/// and size must be multiples of ALIGNMENT. Falls back to memset on targets without SSE2.
+inline void zeroNonTemporal(void* memory, std::size_t size) {
+#if defined(__SSE2__)
+	assert((reinterpret_cast<std::uintptr_t>(memory) & (ALIGNMENT - 1)) == 0);
+	assert((size & (ALIGNMENT - 1)) == 0);
+	const __m128i zero = _mm_setzero_si128();
+	__m128i* p = static_cast<__m128i*>(memory);
+	__m128i* end = p + (size / sizeof(__m128i));
+	for (; p < end; ++p) {
+		_mm_stream_si128(p, zero);
+	}
+	// Order the streaming stores before the stores that initialize the object.
+	_mm_sfence();
+#else // __SSE2__
+	std::memset(memory, 0, size);
+#endif // __SSE2__
+}
+
+/// Clear an object of size bytes at memory, following strategy. The CHUNKED strategy only
+/// applies to the TLH, which is cleared ahead of time, so here it clears with memset.
+inline void zeroObject(ZeroingStrategy strategy, void* memory, std::size_t size) {
+	if (strategy == ZeroingStrategy::STREAMING && size >= STREAMING_ZERO_MINIMUM) {
+		zeroNonTemporal(memory, size);
+	} else {
+		std::memset(memory, 0, size);
+	}
+}
+
+} // namespace Splash
+
+#endif // SPLASH_ZEROING_HPP_
@@ -21,18 +21,35 @@
  *******************************************************************************/
 
 #include <Splash/Allocators.hpp>
+#include <Splash/ArrayScanner.hpp>
 #include <Splash/Barriers.hpp>
+#include <Splash/BatchAllocators.hpp>
+#include <Splash/External.hpp>
+#include <Splash/Kernels.hpp>
+#include <Splash/Region.hpp>
+#include <OMR/GC/StackRoot.hpp>
 
 #include <iostream>
 #include <chrono>
 #include <cstdlib>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <random>
+#include <vector>
 
 constexpr std::size_t RUNS           =        5;
 constexpr std::size_t MAX_CHILD_SIZE =     1000;
 constexpr std::size_t ROOT_SIZE      =      100;
 constexpr std::size_t ITERATIONS     = 10000000;
 constexpr std::size_t SLOT_STRIDE    =        3;
+constexpr std::size_t SCAN_SLOTS     =  1000000;
+constexpr std::size_t SCAN_PASSES    =      100;
+constexpr std::size_t MARK_PASSES    =       20;
+constexpr std::size_t BATCH_SIZE     =     1000;
+constexpr std::size_t REQUEST_SIZE   =      100;
+constexpr std::size_t INIT_SLOTS     =       16;
 
 /// The size of the child we are allocating at step i.
 constexpr std::size_t childSize(std::size_t i) {
@@ -45,7 +62,171 @@ constexpr std::size_t index(std::size_t i) {
 }
 
 void gc_bench(OMR::GC::RunContext& cx) {
-	// SPLASH TODO
+	OMR::GC::StackRoot<Splash::RefArray> root(cx);
+	root = Splash::allocateRefArray(cx, ROOT_SIZE);
+	for (std::size_t i = 0; i < ITERATIONS; ++i) {
+		// be careful to allocate the child _before_ dereferencing the root.
+		auto child = (Splash::AnyArray*)Splash::allocateBinArray(cx, childSize(i));
+		Splash::store(cx, *root, index(i), child);
+	}
+}
+
+/// Like gc_bench, but allocate each BinArray from zeroed memory, the way a RefArray
+/// is allocated, rather than from the non-zeroed TLH.
+void zeroed_bench(OMR::GC::RunContext& cx) {
+	OMR::GC::StackRoot<Splash::RefArray> root(cx);
+	root = Splash::allocateRefArray(cx, ROOT_SIZE);
+	for (std::size_t i = 0; i < ITERATIONS; ++i) {
+		std::size_t nbytes = childSize(i);
+		auto child = (Splash::AnyArray*)Splash::inlineAllocate<Splash::BinArray>(
+			cx, Splash::binArraySize(nbytes), Splash::InitBinArray(nbytes));
+		Splash::store(cx, *root, index(i), child);
+	}
+}
+
+/// The number of bytes zeroed_bench clears, and gc_bench does not.
+std::size_t zeroed_bytes() {
+	std::size_t total = 0;
+	for (std::size_t i = 0; i < ITERATIONS; ++i) {
+		total += Splash::binArraySize(childSize(i));
+	}
+	return total;
+}
+
+/// Like gc_bench, but every child is a RefArray, so every allocation is zeroed.
+/// Run once per -XzeroStrategy to compare the zeroing strategies.
+void zeroing_bench(OMR::GC::RunContext& cx) {
+	OMR::GC::StackRoot<Splash::RefArray> root(cx);
+	root = Splash::allocateRefArray(cx, ROOT_SIZE);
+	for (std::size_t i = 0; i < ITERATIONS; ++i) {
+		auto child = (Splash::AnyArray*)Splash::allocateRefArray(cx, childSize(i));
+		Splash::store(cx, *root, index(i), child);
+	}
+}
+
+/// Print the TLH refresh counts of the calling thread, for the zeroed and non-zeroed TLHs.
+void tlh_report(OMR::GC::RunContext& cx) {
+	for (bool zeroed : {true, false}) {
+		std::cout << (zeroed ? "zeroed tlh:" : "non-zeroed tlh:")
+		          << " refreshes: " << Splash::tlhRefreshCount(cx, zeroed)
+		          << ", failures: " << Splash::tlhRefreshFailures(cx, zeroed)
+		          << ", refresh size: " << Splash::tlhRefreshSize(cx, zeroed) << "\n";
+	}
+}
+
+/// Print the number of global collections, and of scavenges when the scavenger is enabled.
+void gc_report(OMR::GC::RunContext& cx) {
+	MM_GCExtensionsBase* extensions = cx.env()->getExtensions();
+	std::cout << "global collections: " << extensions->globalGCStats.gcCount << "\n";
+#if defined(OMR_GC_MODRON_SCAVENGER)
+	if (extensions->scavengerEnabled) {
+		std::cout << "scavenges: " << extensions->scavengerStats._gcCount << "\n";
+	}
+#endif // OMR_GC_MODRON_SCAVENGER
+}
+
+/// Handle one request: allocate REQUEST_SIZE temporary buffers, held by a request-local
+/// RefArray, all of which die when the request ends.
+void handle_request(OMR::GC::RunContext& cx, std::size_t request) {
+	OMR::GC::StackRoot<Splash::RefArray> temps(cx);
+	temps = Splash::allocateRefArray(cx, REQUEST_SIZE);
+	for (std::size_t i = 0; i < REQUEST_SIZE; ++i) {
+		auto child = (Splash::AnyArray*)Splash::allocateBinArray(cx, childSize(request + i));
+		Splash::store(cx, *temps, i, child);
+	}
+}
+
+/// Handle ITERATIONS / REQUEST_SIZE requests, leaving their temporaries to the GC.
+void request_bench(OMR::GC::RunContext& cx) {
+	for (std::size_t request = 0; request < ITERATIONS / REQUEST_SIZE; ++request) {
+		handle_request(cx, request);
+	}
+}
+
+/// Handle the same requests, each in its own region, and report how many were reclaimed
+/// at scope exit rather than left to the GC.
+void region_bench(OMR::GC::RunContext& cx) {
+	std::size_t reclaimed = 0;
+	for (std::size_t request = 0; request < ITERATIONS / REQUEST_SIZE; ++request) {
+		Splash::Region region(cx);
+		handle_request(cx, request);
+		if (region.close()) {
+			reclaimed += 1;
+		}
+	}
+	std::cout << "requests reclaimed: " << reclaimed << " of " << ITERATIONS / REQUEST_SIZE << "\n";
+}
+
+/// Sum the bytes of a BinArray or ExternalBinArray, through its data span.
+std::uint64_t checksum(Splash::AnyArray* any) {
+	std::uint64_t sum = 0;
+	for (std::uint8_t byte : Splash::data(any)) {
+		sum += byte;
+	}
+	return sum;
+}
+
+/// Read the file at path into a heap BinArray, and checksum it.
+void copy_bench(OMR::GC::RunContext& cx, const char* path) {
+	std::FILE* file = std::fopen(path, "rb");
+	if (file == nullptr) {
+		return;
+	}
+	std::fseek(file, 0, SEEK_END);
+	long end = std::ftell(file);
+	// A BinArray holds at most UINT32_MAX bytes.
+	if (end < 0 || std::uint64_t(end) > UINT32_MAX) {
+		std::fclose(file);
+		return;
+	}
+	std::size_t nbytes = std::size_t(end);
+	std::fseek(file, 0, SEEK_SET);
+	OMR::GC::StackRoot<Splash::BinArray> copy(cx);
+	copy = Splash::allocateBinArray(cx, nbytes);
+	std::size_t read = std::fread(copy->data, 1, nbytes, file);
+	std::fclose(file);
+	std::cout << "read: " << read << " bytes, checksum: " << checksum((Splash::AnyArray*)copy.get()) << "\n";
+}
+
+/// Map the file at path into an ExternalBinArray, and checksum it in place.
+void map_bench(OMR::GC::RunContext& cx, const char* path) {
+	OMR::GC::StackRoot<Splash::ExternalBinArray> mapped(cx);
+	mapped = Splash::mapFile(cx, path);
+	if (mapped == nullptr) {
+		return;
+	}
+	std::cout << "mapped: " << mapped->length() << " bytes, checksum: " << checksum((Splash::AnyArray*)mapped.get()) << "\n";
+}
+
+/// The size of the i'th buffer of a batch: small, and varied.
+constexpr std::size_t bufferSize(std::size_t i) {
+	return 16 + (i % 8) * 16;
+}
+
+/// Allocate ITERATIONS small buffers, BATCH_SIZE at a time, one call per buffer.
+void single_bench(OMR::GC::RunContext& cx) {
+	OMR::GC::StackRoot<Splash::RefArray> root(cx);
+	root = Splash::allocateRefArray(cx, BATCH_SIZE);
+	for (std::size_t batch = 0; batch < ITERATIONS / BATCH_SIZE; ++batch) {
+		for (std::size_t i = 0; i < BATCH_SIZE; ++i) {
+			auto child = (Splash::AnyArray*)Splash::allocateBinArray(cx, bufferSize(i));
+			Splash::store(cx, *root, i, child);
+		}
+	}
+}
+
+/// Allocate ITERATIONS small buffers, BATCH_SIZE at a time, one call per batch.
+void batch_bench(OMR::GC::RunContext& cx) {
+	std::size_t sizes[BATCH_SIZE];
+	for (std::size_t i = 0; i < BATCH_SIZE; ++i) {
+		sizes[i] = bufferSize(i);
+	}
+
+	OMR::GC::StackRoot<Splash::RefArray> root(cx);
+	root = Splash::allocateRefArray(cx, BATCH_SIZE);
+	for (std::size_t batch = 0; batch < ITERATIONS / BATCH_SIZE; ++batch) {
+		Splash::allocateBinArrays(cx, sizes, BATCH_SIZE, root);
+	}
 }
 
 void malloc_bench() {
@@ -60,6 +241,33 @@ void malloc_bench() {
 	}
 }
 
+#if defined(OMR_GC_SEGREGATED_HEAP)
+/// Report the internal fragmentation of gc_bench in the segregated heap: the bytes
+/// lost rounding each object up to the cell size of its size class.
+void sizeclass_report() {
+	OMR_SizeClasses* sizeClasses = MM_LanguageSegregatedAllocationCache::getSizeClasses();
+	std::size_t requested = 0;
+	std::size_t allocated = 0;
+	auto account = [&](std::size_t size) {
+		requested += size;
+		if (size < OMR_SIZECLASSES_MAX_SMALL_SIZE_BYTES) {
+			allocated += sizeClasses->smallCellSizes[sizeClasses->sizeClassIndex[size >> 2]];
+		} else {
+			allocated += size;
+		}
+	};
+
+	account(Splash::refArraySize(ROOT_SIZE));
+	for (std::size_t i = 0; i < MAX_CHILD_SIZE; ++i) {
+		account(Splash::binArraySize(childSize(i)));
+	}
+
+	std::cout << "requested: " << requested << "B, "
+	          << "allocated: " << allocated << "B, "
+	          << "waste: " << double(allocated - requested) * 100 / allocated << "%\n";
+}
+#endif // OMR_GC_SEGREGATED_HEAP
+
 /// Call f(args), and returns the wallclock duration in seconds.
 template <typename F, typename... Args>
 double
@@ -89,6 +297,414 @@ run(F&& f, Args&&... args)
 	return average;
 }
 
+/// Counts the non-null references it is shown.
+class CountingVisitor {
+public:
+	template <typename SlotHandleT>
+	bool edge(void* object, SlotHandleT slot) {
+		count += (slot.readReference() != nullptr);
+		return true;
+	}
+
+	std::size_t count = 0;
+};
+
+/// Counts the non-null references in each run of slots it is shown.
+class BatchCountingVisitor {
+public:
+	template <typename SlotHandleT>
+	bool edge(void* object, SlotHandleT slot) {
+		count += (slot.readReference() != nullptr);
+		return true;
+	}
+
+	bool edges(void* object, Splash::RefSlot* begin, Splash::RefSlot* end) {
+		for (Splash::RefSlot* slot = begin; slot != end; ++slot) {
+			count += (*slot != Splash::RefSlot(0));
+		}
+		return true;
+	}
+
+	std::size_t count = 0;
+};
+
+/// Scan array SCAN_PASSES times. Returns the throughput in bytes per second.
+template <typename VisitorT>
+double scan_throughput(Splash::RefArray* array, VisitorT& visitor) {
+	std::size_t bytes = 0;
+	double duration = time([&] {
+		for (std::size_t pass = 0; pass < SCAN_PASSES; ++pass) {
+			Splash::ArrayScanner scanner;
+			OMR::GC::ScanResult result = scanner.start(visitor, (Splash::AnyArray*)array);
+			assert(result.complete);
+			bytes += result.bytesScanned;
+		}
+	});
+	return bytes / duration;
+}
+
+/// Scan one large, fully populated RefArray over and over. Compare the results of a
+/// build with SPLASH_COMPRESSED_REFS against one without: the slots are half as wide,
+/// so the same array touches half as many cache lines.
+void scan_bench(OMR::GC::RunContext& cx) {
+	OMR::GC::StackRoot<Splash::RefArray> root(cx);
+	root = Splash::allocateRefArray(cx, SCAN_SLOTS);
+	for (std::size_t i = 0; i < SCAN_SLOTS; ++i) {
+		auto child = (Splash::AnyArray*)Splash::allocateBinArray(cx, childSize(i) % 64);
+		Splash::store(cx, *root, i, child);
+	}
+
+	CountingVisitor visitor;
+	double throughput = scan_throughput(root.get(), visitor);
+
+	BatchCountingVisitor batchVisitor;
+	double batchThroughput = scan_throughput(root.get(), batchVisitor);
+
+	std::cout << "slot size:  " << sizeof(Splash::RefSlot) << "B\n"
+	          << "array size: " << Splash::refArraySize(SCAN_SLOTS) << "B\n"
+	          << "edges:      " << visitor.count << "\n"
+	          << "throughput: " << throughput / 1e9 << "GB/s, "
+	          << (throughput / sizeof(Splash::RefSlot)) / 1e6 << "M slots/s\n"
+	          << "batched:    " << batchThroughput / 1e9 << "GB/s, "
+	          << (batchThroughput / sizeof(Splash::RefSlot)) / 1e6 << "M slots/s\n";
+}
+
+/// Scan one large RefArray at a range of slot densities, from every slot null to every
+/// slot populated. Sparse arrays, like hash tables, are dominated by runs of null slots.
+void density_bench(OMR::GC::RunContext& cx) {
+	static const double densities[] = {0.0, 0.001, 0.01, 0.1, 0.5, 1.0};
+
+	OMR::GC::StackRoot<Splash::RefArray> root(cx);
+	OMR::GC::StackRoot<Splash::BinArray> child(cx);
+	root = Splash::allocateRefArray(cx, SCAN_SLOTS);
+	child = Splash::allocateBinArray(cx, 0);
+
+	for (double density : densities) {
+		// Spread the populated slots evenly over the array.
+		std::size_t populated = std::size_t(SCAN_SLOTS * density);
+		for (std::size_t i = 0; i < SCAN_SLOTS; ++i) {
+			bool set = populated != 0 && (i * populated) / SCAN_SLOTS != ((i + 1) * populated) / SCAN_SLOTS;
+			Splash::store(cx, *root, i, set ? (Splash::AnyArray*)child.get() : nullptr);
+		}
+
+		CountingVisitor visitor;
+		double throughput = scan_throughput(root.get(), visitor);
+		std::cout << "density: " << density * 100 << "%, "
+		          << "edges: " << visitor.count / SCAN_PASSES << ", "
+		          << "throughput: " << throughput / 1e9 << "GB/s\n";
+	}
+}
+
+/// Benchmark results are written here, so the work that produced them is never
+/// optimized away.
+volatile std::uint64_t sink = 0;
+
+/// Reads the header of every referent, like a marking visitor testing mark bits.
+class HeaderVisitor {
+public:
+	template <typename SlotHandleT>
+	bool edge(void* object, SlotHandleT slot) {
+		checksum += slot.readReference()->asHeader.value;
+		return true;
+	}
+
+	std::uint64_t checksum = 0;
+};
+
+/// Approximate the mark phase over one large RefArray whose referents are scattered
+/// through the heap, with and without prefetching. Each edge reads the referent's
+/// header, which is a cache miss unless the scanner prefetched it.
+void mark_bench(OMR::GC::RunContext& cx) {
+	static const std::size_t distances[] = {0, 4, 8, 16, 32};
+
+	// Store the children in a random order, so consecutive slots refer to distant objects.
+	std::vector<std::uint32_t> order(SCAN_SLOTS);
+	for (std::size_t i = 0; i < SCAN_SLOTS; ++i) {
+		order[i] = std::uint32_t(i);
+	}
+	std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+	OMR::GC::StackRoot<Splash::RefArray> root(cx);
+	root = Splash::allocateRefArray(cx, SCAN_SLOTS);
+	for (std::size_t i = 0; i < SCAN_SLOTS; ++i) {
+		auto child = (Splash::AnyArray*)Splash::allocateBinArray(cx, 48);
+		Splash::store(cx, *root, order[i], child);
+	}
+
+	for (std::size_t distance : distances) {
+		HeaderVisitor visitor;
+		double duration = time([&] {
+			for (std::size_t pass = 0; pass < MARK_PASSES; ++pass) {
+				Splash::ArrayScanner scanner(distance);
+				OMR::GC::ScanResult result = scanner.start(visitor, (Splash::AnyArray*)root.get());
+				assert(result.complete);
+			}
+		});
+		std::cout << "prefetch distance: " << distance << ", "
+		          << "mark time: " << (duration / MARK_PASSES) * 1e3 << "ms\n";
+		sink = visitor.checksum;
+	}
+}
+
+/// Store ITERATIONS references into a RefArray through the Barrier policy, and report the
+/// store throughput. The stored children are allocated up front, so only stores are timed.
+template <typename Barrier>
+void barrier_bench(OMR::GC::RunContext& cx, const char* name) {
+	OMR::GC::StackRoot<Splash::RefArray> root(cx);
+	OMR::GC::StackRoot<Splash::RefArray> children(cx);
+	root = Splash::allocateRefArray(cx, ROOT_SIZE);
+	children = Splash::allocateRefArray(cx, ROOT_SIZE);
+	for (std::size_t i = 0; i < ROOT_SIZE; ++i) {
+		auto child = (Splash::AnyArray*)Splash::allocateBinArray(cx, childSize(i));
+		Splash::store(cx, *children, i, child);
+	}
+
+	double duration = time([&] {
+		Splash::RefArray& target = *root;
+		Splash::RefArray& source = *children;
+		for (std::size_t i = 0; i < ITERATIONS; ++i) {
+			// Every fourth store is a null, which every policy filters.
+			Splash::AnyArray* value = (i % 4) == 0 ? nullptr : Splash::load(source, i % ROOT_SIZE);
+			// Call the policy directly, so the flat policy can be timed in builds that may not
+			// use it with Splash::store.
+			Splash::regionStore(cx, &target, value);
+			Barrier::store(cx, (Splash::AnyArray*)&target, Splash::at(target, index(i)), value);
+		}
+	});
+	std::cout << name << ": " << duration << "s, "
+	          << (ITERATIONS / duration) / 1e6 << "M stores/s\n";
+}
+
+/// Copy and fill a RefArray of SCAN_SLOTS references SCAN_PASSES times, first one store
+/// per slot, then with arraycopy and fill, and report the time taken by each.
+void arraycopy_bench(OMR::GC::RunContext& cx) {
+	OMR::GC::StackRoot<Splash::RefArray> src(cx);
+	OMR::GC::StackRoot<Splash::RefArray> dst(cx);
+	src = Splash::allocateRefArray(cx, SCAN_SLOTS);
+	dst = Splash::allocateRefArray(cx, SCAN_SLOTS);
+	for (std::size_t i = 0; i < SCAN_SLOTS; ++i) {
+		auto child = (Splash::AnyArray*)Splash::allocateBinArray(cx, childSize(i));
+		Splash::store(cx, *src, i, child);
+	}
+
+	double loopCopy = time([&] {
+		for (std::size_t pass = 0; pass < SCAN_PASSES; ++pass) {
+			for (std::size_t i = 0; i < SCAN_SLOTS; ++i) {
+				Splash::store(cx, *dst, i, Splash::load(*src, i));
+			}
+		}
+	});
+	double batchCopy = time([&] {
+		for (std::size_t pass = 0; pass < SCAN_PASSES; ++pass) {
+			Splash::arraycopy(cx, *src, 0, *dst, 0, SCAN_SLOTS);
+		}
+	});
+	double loopFill = time([&] {
+		for (std::size_t pass = 0; pass < SCAN_PASSES; ++pass) {
+			Splash::AnyArray* value = Splash::load(*src, pass);
+			for (std::size_t i = 0; i < SCAN_SLOTS; ++i) {
+				Splash::store(cx, *dst, i, value);
+			}
+		}
+	});
+	double batchFill = time([&] {
+		for (std::size_t pass = 0; pass < SCAN_PASSES; ++pass) {
+			Splash::fill(cx, *dst, 0, SCAN_SLOTS, Splash::load(*src, pass));
+		}
+	});
+
+	std::cout << "copy, per slot:  " << loopCopy << "s\n"
+	          << "copy, arraycopy: " << batchCopy << "s\n"
+	          << "fill, per slot:  " << loopFill << "s\n"
+	          << "fill, fill:      " << batchFill << "s\n";
+}
+
+/// Allocate ITERATIONS / INIT_SLOTS small RefArrays, and fill each straight after allocating
+/// it, with initStore if Init is set, otherwise with store.
+template <bool Init>
+void init_bench(OMR::GC::RunContext& cx) {
+	OMR::GC::StackRoot<Splash::RefArray> root(cx);
+	OMR::GC::StackRoot<Splash::RefArray> children(cx);
+	root = Splash::allocateRefArray(cx, ROOT_SIZE);
+	children = Splash::allocateRefArray(cx, INIT_SLOTS);
+	for (std::size_t i = 0; i < INIT_SLOTS; ++i) {
+		auto child = (Splash::AnyArray*)Splash::allocateBinArray(cx, childSize(i));
+		Splash::store(cx, *children, i, child);
+	}
+
+	for (std::size_t i = 0; i < ITERATIONS / INIT_SLOTS; ++i) {
+		Splash::RefArray* array;
+		if (Init) {
+			Splash::Fresh<Splash::RefArray> fresh = Splash::allocateRefArrayFresh(cx, INIT_SLOTS);
+			// No collection point from here until the array is stored.
+			Splash::RefArray& source = *children;
+			for (std::size_t j = 0; j < INIT_SLOTS; ++j) {
+				Splash::initStore(cx, fresh, j, Splash::load(source, j));
+			}
+			array = fresh.get();
+		} else {
+			array = Splash::allocateRefArray(cx, INIT_SLOTS);
+			// No collection point from here until the array is stored.
+			Splash::RefArray& source = *children;
+			for (std::size_t j = 0; j < INIT_SLOTS; ++j) {
+				Splash::store(cx, *array, j, Splash::load(source, j));
+			}
+		}
+		Splash::store(cx, *root, index(i), (Splash::AnyArray*)array);
+	}
+}
+
+/// Update a table of ROOT_SIZE slots ITERATIONS times, with store, compareAndSwap and
+/// exchange, and report the time taken by each.
+void atomic_bench(OMR::GC::RunContext& cx) {
+	OMR::GC::StackRoot<Splash::RefArray> table(cx);
+	OMR::GC::StackRoot<Splash::RefArray> children(cx);
+	table = Splash::allocateRefArray(cx, ROOT_SIZE);
+	children = Splash::allocateRefArray(cx, ROOT_SIZE);
+	for (std::size_t i = 0; i < ROOT_SIZE; ++i) {
+		auto child = (Splash::AnyArray*)Splash::allocateBinArray(cx, childSize(i));
+		Splash::store(cx, *children, i, child);
+	}
+
+	double storeTime = time([&] {
+		for (std::size_t i = 0; i < ITERATIONS; ++i) {
+			Splash::store(cx, *table, index(i), Splash::load(*children, i % ROOT_SIZE));
+		}
+	});
+
+	std::size_t failures = 0;
+	double casTime = time([&] {
+		for (std::size_t i = 0; i < ITERATIONS; ++i) {
+			std::size_t slot = index(i);
+			Splash::AnyArray* expected = Splash::loadAcquire(*table, slot);
+			Splash::AnyArray* value = Splash::load(*children, i % ROOT_SIZE);
+			if (!Splash::compareAndSwap(cx, *table, slot, expected, value)) {
+				failures += 1;
+			}
+		}
+	});
+
+	double exchangeTime = time([&] {
+		for (std::size_t i = 0; i < ITERATIONS; ++i) {
+			Splash::exchange(cx, *table, index(i), Splash::load(*children, i % ROOT_SIZE));
+		}
+	});
+
+	std::cout << "store:          " << storeTime << "s\n"
+	          << "compareAndSwap: " << casTime << "s, " << failures << " failures\n"
+	          << "exchange:       " << exchangeTime << "s\n";
+}
+
+/// Check the numeric kernels against plain scalar loops, over arrays of every length up to
+/// four vectors and a few elements, so the vector loops end on every possible tail. The
+/// values are small integers, which every element type adds and multiplies exactly.
+template <typename T>
+bool kernels_check(OMR::GC::RunContext& cx, const char* name) {
+	constexpr std::size_t MAX_LENGTH = 4 * Splash::Lanes<T>::value + 3;
+	OMR::GC::StackRoot<Splash::PrimArray<T>> lhs(cx);
+	OMR::GC::StackRoot<Splash::PrimArray<T>> rhs(cx);
+	OMR::GC::StackRoot<Splash::BinArray> mask(cx);
+	const T value = T(2);
+	bool ok = true;
+	for (std::size_t n = 0; n <= MAX_LENGTH; ++n) {
+		lhs = Splash::allocatePrimArray<T>(cx, n);
+		rhs = Splash::allocatePrimArray<T>(cx, n);
+		mask = Splash::allocateBinArray(cx, n);
+		T* a = lhs->begin();
+		T* b = rhs->begin();
+		for (std::size_t i = 0; i < n; ++i) {
+			a[i] = T(int(i * 7 % 11) - 5);
+			b[i] = T(int(i % 3) + 1);
+		}
+
+		T sum = 0;
+		T dot = 0;
+		std::size_t equal = 0;
+		for (std::size_t i = 0; i < n; ++i) {
+			sum += a[i];
+			dot += a[i] * b[i];
+			equal += a[i] == value;
+		}
+		ok = ok && Splash::sum(*lhs) == sum && Splash::dot(*lhs, *rhs) == dot;
+		if (n != 0) {
+			ok = ok && Splash::minimum(*lhs) == *std::min_element(a, a + n)
+			        && Splash::maximum(*lhs) == *std::max_element(a, a + n);
+		}
+
+		ok = ok && Splash::compareEqual(*lhs, value, *mask) == equal;
+		for (std::size_t i = 0; i < n; ++i) {
+			ok = ok && mask->data[i] == (a[i] == value);
+		}
+
+		Splash::fill(*rhs, value);
+		ok = ok && std::all_of(b, b + n, [&](T x) { return x == value; });
+	}
+	std::cout << name << ": " << (ok ? "ok" : "FAILED") << "\n";
+	return ok;
+}
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+
+/// Allocate short-lived BinArrays until the calling thread has been through collections
+/// more collections.
+void churn(OMR::GC::RunContext& cx, std::size_t collections) {
+	GC_Environment* gcEnv = cx.env()->getGCEnvironment();
+	std::uintptr_t target = gcEnv->gcCount + collections;
+	while (gcEnv->gcCount < target) {
+		Splash::allocateBinArray(cx, MAX_CHILD_SIZE);
+	}
+}
+
+/// Allocate short-lived BinArrays until the object held by root is tenured. Returns false
+/// if it is still in the nursery after ITERATIONS allocations.
+template <typename T>
+bool tenure(OMR::GC::RunContext& cx, OMR::GC::StackRoot<T>& root) {
+	for (std::size_t i = 0; i < ITERATIONS; ++i) {
+		if (Splash::isOld(cx, (Splash::AnyArray*)root.get())) {
+			return true;
+		}
+		Splash::allocateBinArray(cx, MAX_CHILD_SIZE);
+	}
+	return false;
+}
+
+/// Copy [old, young] into a tenured RefArray with arraycopy, drop every other reference to
+/// the young BinArray, and check that it survives the following scavenges. The first value
+/// being old must not stop the barrier from remembering the tenured array.
+template <typename Barrier>
+bool remembered_check(OMR::GC::RunContext& cx, const char* name) {
+	constexpr std::uint8_t PATTERN = 0x5a;
+	OMR::GC::StackRoot<Splash::RefArray> dst(cx);
+	OMR::GC::StackRoot<Splash::BinArray> old(cx);
+	OMR::GC::StackRoot<Splash::RefArray> src(cx);
+	dst = Splash::allocateRefArray(cx, 2);
+	old = Splash::allocateBinArray(cx, 1);
+	if (!tenure(cx, dst) || !tenure(cx, old)) {
+		std::cout << name << ": could not tenure the destination\n";
+		return false;
+	}
+
+	src = Splash::allocateRefArray(cx, 2);
+	Splash::BinArray* young = Splash::allocateBinArray(cx, MAX_CHILD_SIZE);
+	std::memset(young->data, PATTERN, MAX_CHILD_SIZE);
+	Splash::store(cx, *src, 1, (Splash::AnyArray*)young);
+	Splash::store(cx, *src, 0, (Splash::AnyArray*)old.get());
+	Splash::arraycopy<Barrier>(cx, *src, 0, *dst, 0, 2);
+	src = nullptr;
+
+	churn(cx, 2);
+	Splash::AnyArray* survivor = Splash::load(*dst, 1);
+	bool ok = Splash::load(*dst, 0) == (Splash::AnyArray*)old.get()
+	       && Splash::kind(survivor) == Splash::Kind::BIN
+	       && survivor->asHeader.length() == MAX_CHILD_SIZE
+	       && std::all_of(survivor->asBinArray.data, survivor->asBinArray.data + MAX_CHILD_SIZE,
+	                      [&](std::uint8_t b) { return b == PATTERN; });
+	std::cout << name << ": " << (ok ? "ok" : "FAILED") << "\n";
+	return ok;
+}
+
+#endif // OMR_GC_MODRON_SCAVENGER
+
 extern "C" int
 main(int argc, char** argv)
 {
@@ -96,6 +712,166 @@ main(int argc, char** argv)
 	OMR::GC::System system(runtime);
 	OMR::GC::Context context(system);
 
+	if (argc > 1 && std::strcmp(argv[1], "scan") == 0) {
+		std::cout << "benchmark: scan\n";
+		scan_bench(context);
+		return 0;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "density") == 0) {
+		std::cout << "benchmark: density\n";
+		density_bench(context);
+		return 0;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "mark") == 0) {
+		std::cout << "benchmark: mark\n";
+		mark_bench(context);
+		return 0;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "batch") == 0) {
+		std::cout << "benchmark: single\n";
+		double singleTime = run(single_bench, context);
+		std::cout << "\n"
+		          << "benchmark: batch\n";
+		double batchTime = run(batch_bench, context);
+		std::cout << "\n"
+		          << "diff: " << singleTime - batchTime << "s\n";
+		return 0;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "nonzero") == 0) {
+		std::cout << "benchmark: zeroed\n";
+		double zeroedTime = run(zeroed_bench, context);
+		std::cout << "\n"
+		          << "benchmark: nonzero\n";
+		double nonZeroTime = run(gc_bench, context);
+		std::cout << "\n"
+		          << "diff: " << zeroedTime - nonZeroTime << "s, "
+		          << "bytes not zeroed: " << zeroed_bytes() << "\n";
+		return 0;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "region") == 0) {
+		std::cout << "benchmark: requests\n";
+		double gcTime = run(request_bench, context);
+		std::cout << "\n"
+		          << "benchmark: region\n";
+		double regionTime = run(region_bench, context);
+		std::cout << "\n"
+		          << "diff: " << gcTime - regionTime << "s\n";
+		return 0;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "mapped") == 0) {
+		// Checksum the file named on the command line, or this executable.
+		const char* path = argc > 2 ? argv[2] : argv[0];
+		std::cout << "benchmark: copy\n";
+		double copyTime = run(copy_bench, context, path);
+		std::cout << "\n"
+		          << "benchmark: mapped\n";
+		double mapTime = run(map_bench, context, path);
+		std::cout << "\n"
+		          << "diff: " << copyTime - mapTime << "s\n";
+		return 0;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "barrier") == 0) {
+		std::cout << "benchmark: barrier\n";
+		barrier_bench<Splash::FlatBarrier>(context, "flat");
+#if defined(OMR_GC_MODRON_SCAVENGER)
+		barrier_bench<Splash::GenconBarrier>(context, "gencon");
+#endif // OMR_GC_MODRON_SCAVENGER
+		barrier_bench<Splash::ConcurrentBarrier>(context, "concurrent");
+		return 0;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "arraycopy") == 0) {
+		std::cout << "benchmark: arraycopy\n";
+		arraycopy_bench(context);
+		return 0;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "init") == 0) {
+		std::cout << "benchmark: store\n";
+		double storeTime = run(init_bench<false>, context);
+		std::cout << "\n"
+		          << "benchmark: initStore\n";
+		double initTime = run(init_bench<true>, context);
+		std::cout << "\n"
+		          << "diff: " << storeTime - initTime << "s\n";
+		return 0;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "atomic") == 0) {
+		std::cout << "benchmark: atomic\n";
+		atomic_bench(context);
+		return 0;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "collections") == 0) {
+		std::cout << "benchmark: collections\n";
+		run(gc_bench, context);
+		std::cout << "\n";
+		gc_report(context);
+#if defined(OMR_GC_MODRON_SCAVENGER)
+		// The nursery should absorb every short-lived BinArray.
+		MM_GCExtensionsBase* extensions = context.env()->getExtensions();
+		if (extensions->scavengerEnabled && extensions->globalGCStats.gcCount != 0) {
+			std::cout << "FAILED: global collections with the scavenger enabled\n";
+			return 1;
+		}
+#endif // OMR_GC_MODRON_SCAVENGER
+		return 0;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "kernels") == 0) {
+		std::cout << "check: kernels\n";
+		bool ok = kernels_check<std::int32_t>(context, "i32");
+		ok = kernels_check<std::int64_t>(context, "i64") && ok;
+		ok = kernels_check<float>(context, "f32") && ok;
+		ok = kernels_check<double>(context, "f64") && ok;
+		return ok ? 0 : 1;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "remembered") == 0) {
+		std::cout << "check: remembered\n";
+#if defined(OMR_GC_MODRON_SCAVENGER)
+		bool ok = remembered_check<Splash::GenconBarrier>(context, "gencon");
+		ok = remembered_check<Splash::ConcurrentBarrier>(context, "concurrent") && ok;
+		return ok ? 0 : 1;
+#else // OMR_GC_MODRON_SCAVENGER
+		std::cout << "requires the scavenger\n";
+		return 0;
+#endif // OMR_GC_MODRON_SCAVENGER
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "tlh") == 0) {
+		std::cout << "benchmark: tlh\n";
+		run(gc_bench, context);
+		std::cout << "\n";
+		tlh_report(context);
+		return 0;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "zeroing") == 0) {
+		std::cout << "benchmark: zeroing\n";
+		run(zeroing_bench, context);
+		return 0;
+	}
+
+#if defined(OMR_GC_SEGREGATED_HEAP)
+	if (argc > 1 && std::strcmp(argv[1], "sizeclasses") == 0) {
+		std::cout << "benchmark: sizeclasses\n";
+		sizeclass_report();
+		std::cout << "\n"
+		          << "benchmark: gc\n";
+		run(gc_bench, context);
+		return 0;
+	}
+#endif // OMR_GC_SEGREGATED_HEAP
+
 	std::cout << "benchmark: gc\n";
 	double gcTime = run(gc_bench, context);
 	std::cout << "\n"